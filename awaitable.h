@@ -0,0 +1,141 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version: intrusive list of suspended coroutines, batched resumption, detached task
+
+  2026.10.18 Closing the list: coroutines resumed with the mark that the event will never come
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef AWAITABLE_H_INCLUDED
+#define AWAITABLE_H_INCLUDED
+
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace CoreAGI {
+                                                                                                                              /*
+  Scope of batched resumption: while the batch exists, coroutines woken by this thread (e.g. fitter that
+  processes many channels) are collected and resumed together when the batch is destroyed, instead of
+  being resumed one by one in the middle of the processing. Batches can be nested:
+                                                                                                                              */
+  class FitBatch {
+
+    inline static thread_local FitBatch* current{ nullptr };
+
+    FitBatch*                              previous;
+    std::vector< std::coroutine_handle<> > H;
+
+  public:
+
+    FitBatch(): previous{ current }, H{}{ current = this; }
+
+    FitBatch( const FitBatch& ) = delete;
+    FitBatch& operator= ( const FitBatch& ) = delete;
+
+   ~FitBatch(){
+      current = previous;
+      for( auto h: H ) h.resume();
+    }
+                                                                                                                              /*
+    Resume `h` now or at the end of the current batch of the thread:
+                                                                                                                              */
+    static void resume( std::coroutine_handle<> h ){
+      if( current ) current->H.push_back( h );
+      else          h.resume();
+    }
+
+    std::size_t size() const { return H.size(); }
+
+  };//FitBatch
+                                                                                                                              /*
+  Coroutines suspended until an event. Nodes are parts of awaiters (frames of suspended coroutines), so
+  list needs no allocation; the mutex is held only to link node or to take the whole list:
+                                                                                                                              */
+  class Waiters {
+
+  public:
+
+    struct Node {
+      std::coroutine_handle<> handle{};
+      Node*                   next  { nullptr };
+      bool                    closed{ false };   // :resumed by `close`, not by the event
+    };
+
+  private:
+
+    std::mutex mutex;
+    Node*      head;
+
+  public:
+
+    Waiters(): mutex{}, head{ nullptr }{}
+
+    Waiters( const Waiters& ) = delete;
+    Waiters& operator= ( const Waiters& ) = delete;
+                                                                                                                              /*
+    Link the node unless `ready()`; predicate checked under the mutex, so event signalled by `resume`
+    concurrently is never missed. Returns true if linked (coroutine stays suspended):
+                                                                                                                              */
+    template< typename Ready > bool push( Node& node, Ready ready ){
+      const std::lock_guard< std::mutex > lock( mutex );
+      if( ready() ) return false;
+      node.next = head;
+      head      = &node;
+      return true;
+    }
+                                                                                                                              /*
+    Resume all linked coroutines (in order of suspension); caller changes state checked by `ready` before.
+    When `closed`, nodes are marked so before resumption (e.g. source of events destroyed):
+                                                                                                                              */
+    void resume( bool closed = false ){
+      Node* list{ nullptr };
+      {
+        const std::lock_guard< std::mutex > lock( mutex );
+        list = head;
+        head = nullptr;
+      }
+      Node* reversed{ nullptr };
+      while( list ){
+        Node* next{ list->next };
+        list->next   = reversed;
+        list->closed = closed;
+        reversed     = list;
+        list         = next;
+      }
+      while( reversed ){
+        Node* next{ reversed->next }; // :node is destroyed by resumed coroutine
+        FitBatch::resume( reversed->handle );
+        reversed = next;
+      }
+    }
+
+    void close(){ resume( true ); }
+
+    bool empty(){
+      const std::lock_guard< std::mutex > lock( mutex );
+      return head == nullptr;
+    }
+
+  };//Waiters
+                                                                                                                              /*
+  Minimal coroutine type: starts immediately, runs until completion being resumed by awaited events, and
+  destroys itself; result is delivered by side effects:
+                                                                                                                              */
+  struct Task {
+    struct promise_type {
+      Task                get_return_object()         { return {}; }
+      std::suspend_never  initial_suspend() noexcept  { return {}; }
+      std::suspend_never  final_suspend  () noexcept  { return {}; }
+      void                return_void()               {}
+      void                unhandled_exception()       { std::terminate(); }
+    };
+  };
+
+}//CoreAGI
+
+#endif // AWAITABLE_H_INCLUDED
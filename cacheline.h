@@ -0,0 +1,80 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version: cache line size, layout modes, padded wrapper and container
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef CACHELINE_H_INCLUDED
+#define CACHELINE_H_INCLUDED
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace CoreAGI {
+                                                                                                                              /*
+  Cache line size used to separate data written by different threads. It can be redefined by the
+  compiler option `-DCORE_AGI_CACHE_LINE=...`; `std::hardware_destructive_interference_size` is not used
+  because its value is not ABI-stable when used in headers:
+                                                                                                                              */
+#ifdef CORE_AGI_CACHE_LINE
+  constexpr std::size_t CACHE_LINE{ CORE_AGI_CACHE_LINE };
+#else
+  constexpr std::size_t CACHE_LINE{ 64 };
+#endif
+
+  static_assert( ( CACHE_LINE & ( CACHE_LINE - 1 ) ) == 0, "Cache line size must be a power of 2" );
+                                                                                                                              /*
+  Memory layout of objects shared by several threads:
+    COMPACT - fields placed next to each other (minimal footprint)
+    PADDED  - groups of fields written by different threads placed on distinct cache lines
+                                                                                                                              */
+  enum class Layout: unsigned { COMPACT = 0, PADDED };
+                                                                                                                              /*
+  Alignment of the first field of the group of fields of type T:
+                                                                                                                              */
+  template< typename T > constexpr std::size_t alignment( Layout layout ){
+    return layout == Layout::PADDED ? CACHE_LINE : alignof( T );
+  }
+                                                                                                                              /*
+  Wrapper that occupies whole cache lines, so neighbours in array never share a cache line:
+                                                                                                                              */
+  template< typename T > struct alignas( CACHE_LINE ) Padded: T {
+    using T::T;
+    Padded( const T& x ): T{ x }{}
+  };
+                                                                                                                              /*
+  Fixed size array of padded elements constructed with the same arguments; elements are never relocated:
+                                                                                                                              */
+  template< typename T > class Channels {
+
+    std::vector< Padded< T > > E;
+
+  public:
+
+    template< typename... Args > Channels( std::size_t n, const Args&... args ): E{}{
+      E.reserve( n );
+      for( std::size_t i = 0; i < n; i++ ) E.emplace_back( args... );
+    }
+
+    Channels( const Channels& ) = delete;
+    Channels& operator= ( const Channels& ) = delete;
+
+    std::size_t size() const { return E.size(); }
+
+          T& operator[] ( std::size_t i )       { return E[i]; }
+    const T& operator[] ( std::size_t i ) const { return E[i]; }
+
+    auto begin()       { return E.begin(); }
+    auto end  ()       { return E.end  (); }
+    auto begin() const { return E.begin(); }
+    auto end  () const { return E.end  (); }
+
+  };//Channels
+
+}//CoreAGI
+
+#endif // CACHELINE_H_INCLUDED
@@ -0,0 +1,131 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+______________________________________________________________________________
+
+ 2026.10.18
+
+ Contention benchmark: array of `Dynamic` channels shared by producer, fitter and reader threads;
+ COMPACT and PADDED layouts, each in plain `std::vector` and in `Channels` container, so the effect of the
+ layout and of the container is measured separately.
+ Built with `-DCORE_AGI_TRACE` writes trace zones of `process` into `contention.json` (Chrome trace).
+
+   g++ -std=c++20 -O2 -pthread contention.cpp -o contention
+   ./contention [ channels [ producers [ fitters [ readers [ millisec ] ] ] ] ]
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "polynomial.h"
+#include "dynamic.h"
+
+using namespace CoreAGI;
+
+struct Counts {
+  unsigned long long updates;
+  unsigned long long fits;
+  unsigned long long reads;
+};
+
+template< typename Array > Counts run( Array& channels, unsigned P, unsigned F, unsigned R, unsigned millisec ){
+                                                                                                                              /*
+  Channel `i` is written by producer `i % P`, fitted by fitter `i % F` and read by reader `i % R`, so neighbouring
+  channels are always touched by different threads:
+                                                                                                                              */
+  const unsigned      C{ unsigned( channels.size() ) };
+  std::atomic< bool > stop{ false };
+  std::atomic< unsigned long long > updates{ 0 }, fits{ 0 }, reads{ 0 };
+  std::vector< std::thread > threads;
+
+  for( auto p: RANGE{ P } ) threads.emplace_back( [&,p]{
+    unsigned long long n{ 0 };
+    double t{ 0.0 };
+    while( not stop.load( std::memory_order_relaxed ) ){
+      t += 0.01;
+      for( unsigned i = p; i < C; i += P ) channels[i].update( t, sin( t + i ) );
+      n++;
+    }
+    updates += n*( ( C - p + P - 1 )/P );
+  });
+
+  for( auto f: RANGE{ F } ) threads.emplace_back( [&,f]{
+    unsigned long long n{ 0 };
+    while( not stop.load( std::memory_order_relaxed ) ){
+      for( unsigned i = f; i < C; i += F ) if( channels[i].mutant.load() ){ channels[i].process(); n++; }
+    }
+    fits += n;
+  });
+
+  for( auto r: RANGE{ R } ) threads.emplace_back( [&,r]{
+    unsigned long long n{ 0 };
+    double s{ 0.0 };
+    while( not stop.load( std::memory_order_relaxed ) ){
+      for( unsigned i = r; i < C; i += R ){ const auto v{ channels[i]( 1.0 ) }; if( not std::isnan( v ) ) s += v; n++; }
+    }
+    reads += n + ( s == 0.125 ? 1 : 0 ); // :keep `s` alive
+  });
+
+  CoreAGI::sleep( millisec );
+  stop.store( true );
+  for( auto& thread: threads ) thread.join();
+  return Counts{ updates.load(), fits.load(), reads.load() };
+}
+
+int main( int argc, char* argv[] ){
+
+  constexpr unsigned L{ 32 };
+
+  const unsigned C       { argc > 1 ? unsigned( atoi( argv[1] ) ) :  64 };
+  const unsigned P       { argc > 2 ? unsigned( atoi( argv[2] ) ) :   2 };
+  const unsigned F       { argc > 3 ? unsigned( atoi( argv[3] ) ) :   1 };
+  const unsigned R       { argc > 4 ? unsigned( atoi( argv[4] ) ) :   2 };
+  const unsigned MILLISEC{ argc > 5 ? unsigned( atoi( argv[5] ) ) : 1000 };
+
+  using Compact = Dynamic< 4, double, Layout::COMPACT >;
+  using Aligned = Dynamic< 4, double, Layout::PADDED  >;
+
+  printf( "\n CONTENTION BENCHMARK: %u channels, %u producers, %u fitters, %u readers, %u millisec\n",
+    C, P, F, R, MILLISEC );
+  printf( "\n   sizeof COMPACT %4zu bytes, in Channels %4zu bytes", sizeof( Compact ), sizeof( Padded< Compact > ) );
+  printf( "\n   sizeof PADDED  %4zu bytes, in Channels %4zu bytes\n", sizeof( Aligned ), sizeof( Padded< Aligned > ) );
+
+  auto report = []( const char* title, const Counts& c, unsigned millisec ){
+    const double sec{ 1.0e-3*millisec };
+    printf( "\n   %-16s updates %10.3e/sec   fits %10.3e/sec   reads %10.3e/sec",
+      title, double( c.updates )/sec, double( c.fits )/sec, double( c.reads )/sec );
+  };
+
+  {
+    std::vector< Compact > channels;
+    channels.reserve( C );
+    for( auto i: RANGE{ C } ){ (void)i; channels.emplace_back( L, Chebyshev4 ); }
+    report( "COMPACT vector", run( channels, P, F, R, MILLISEC ), MILLISEC );
+  }
+  {
+    std::vector< Aligned > channels;
+    channels.reserve( C );
+    for( auto i: RANGE{ C } ){ (void)i; channels.emplace_back( L, Chebyshev4 ); }
+    report( "PADDED vector", run( channels, P, F, R, MILLISEC ), MILLISEC );
+  }
+  {
+    Channels< Compact > channels( C, L, Chebyshev4 );
+    report( "COMPACT Channels", run( channels, P, F, R, MILLISEC ), MILLISEC );
+  }
+  {
+    Channels< Aligned > channels( C, L, Chebyshev4 );
+    report( "PADDED Channels", run( channels, P, F, R, MILLISEC ), MILLISEC );
+  }
+  printf( "\n" );
+#ifdef CORE_AGI_TRACE
+  Trace::dump( "contention.json" );
+#endif
+
+  return EXIT_SUCCESS;
+}
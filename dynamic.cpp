@@ -8,6 +8,40 @@ ______________________________________________________________________________
 
  2021.12.08 Assignment text added
 
+ 2026.10.18 Move and copy-on-write fork test added
+
+ 2026.10.18 Lookahead grid test added
+
+ 2026.10.18 Polynomial algebra test added
+
+ 2026.10.18 Roots and extrema test added
+
+ 2026.10.18 Warm start test added
+
+ 2026.10.18 Forsythe fitting test added
+
+ 2026.10.18 Chebyshev basis and series test added
+
+ 2026.10.18 Rate-adaptive ingest test added
+
+ 2026.10.18 Registry test added
+
+ 2026.10.18 Shared memory publication test added
+
+ 2026.10.18 Checkpoint and restore test added
+
+ 2026.10.18 Cycle counter timer and trace zones test added
+
+ 2026.10.18 Awaiting the next approximation test added
+
+ 2026.10.18 Multi-resolution pyramid test added
+
+ 2026.10.18 Parallel ordering Jacobi test added
+
+ 2026.10.18 Out-of-order ingest test added
+
+ 2026.10.18 Single sample after `clear` concurrent with `process` test added
+
  Test application for `Dynamic` module
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
@@ -16,8 +50,40 @@ ________________________________________________________________________________
 
 #include "polynomial.h"
 #include "dynamic.h"
+#include "registry.h"
+#include "shmem.h"
+#include "checkpoint.h"
+#include "pyramid.h"
+
+#include <unistd.h> // :getpid
 
 using namespace CoreAGI;
+                                                                                                                              /*
+Consumer awaiting `n` approximations of `D`; records time of the newest sample of each one, or NaN when
+`D` destroyed before publication:
+                                                                                                                              */
+Task consume( const Dynamic< 4 >& D, unsigned n, std::vector< double >& Tt ){
+  for( auto i: RANGE{ n } ){
+    (void)i;
+    const auto fit{ co_await D.next_fit() };
+    if( not fit ){ Tt.push_back( NAN ); co_return; }
+    Tt.push_back( std::get< 2 >( *fit ) );
+  }
+}
+                                                                                                                              /*
+Consumer that changes `D` when resumed: switches fitting method and refits with one more sample:
+                                                                                                                              */
+Task refit( Dynamic< 4 >& D, std::vector< double >& Tt ){
+  const auto fit{ co_await D.next_fit() };
+  if( not fit ) co_return;
+  const double tt{ std::get< 2 >( *fit ) };
+  Tt.push_back( tt );
+  D.fitting( Fitting::FORSYTHE );
+  D.tolerance( 1.0e-12 );
+  D.update( tt + 1.0, 0.0 );
+  D.process();
+  Tt.push_back( std::get< 2 >( D.def() ) );
+}
 
 int main(){
 
@@ -52,7 +118,7 @@ int main(){
       constexpr Time ANOTHER_TIME  { 1.00 };
       f.update( SOME_TIME, CONSTANT_VALUE );
       const auto V{ f( ANOTHER_TIME ) };
-      if( fabs( V - CONSTANT_VALUE ) > 1.0e-6 ){
+      if( not ( fabs( V - CONSTANT_VALUE ) <= 1.0e-6 ) ){
         correct = false;
         printf( "\n Test result: failed; expeced %.3f but got %.3f\n", CONSTANT_VALUE, V );
       } else {
@@ -154,6 +220,36 @@ int main(){
     } catch(...){
       printf( " [failed]\n" );
       correct = false;
+    }
+                                                                                                                              /*
+    Test move and copy-on-write fork:
+                                                                                                                              */
+    printf( "\n\n TEST FOR MOVE AND COPY-ON-WRITE FORK " );
+    static_assert( std::is_nothrow_move_constructible_v< decltype( h ) > );
+    static_assert( std::is_nothrow_move_assignable_v   < decltype( h ) > );
+    {
+      const Real before{ h( 0.5 ) };
+      auto fork{ h };
+      bool ok{ fork.shared() };
+      fork.update( 1.2, 0.0 );
+      ok = ok and not fork.shared();
+      ok = ok and h.length() == L and fork.length() == L and fork.mutant.load() and not h.mutant.load();
+      auto moved{ std::move( fork ) };
+      ok = ok and moved.length() == L and moved.mutant.load();
+      moved.process();
+      ok = ok and h( 0.5 ) == before and moved.defined();
+      fork.update( 1.3, 0.0 ); // :moved-from object allocates new queue
+      ok = ok and fork.length() == 1 and not fork.shared();
+      {
+        auto copy{ std::make_unique< decltype( h ) >( moved ) };
+        std::vector< decltype( h )::Sample > R( L );
+        std::thread reader( [&]{ copy->samples( R.data() ); copy.reset(); } ); // :copy read and destroyed
+        for( auto i: RANGE{ 4u } ) moved.update( 1.4 + 0.1*i, 0.0 );
+        reader.join();
+        ok = ok and R[ L-1 ].t == 1.2 and moved.length() == L;
+      }
+      printf( ok ? " [ok]\n" : " [failed]\n" );
+      if( not ok ) correct = false;
     }
   }
 
@@ -178,6 +274,9 @@ int main(){
     auto X{ Dynamic( L, Chebyshev6 ) };
     auto Y{ Dynamic( L, Chebyshev6 ) };
 
+    constexpr Time LOOKAHEAD[]{ 0.5, 1.0, 2.0, 4.0 };
+    X.lookahead( LOOKAHEAD );
+
     for( auto i: RANGE{ L } ){
       const Time t{ Time( i ) };
       X.update( t, x( t ) );
@@ -203,6 +302,32 @@ int main(){
       printf( "\n   Elapsed time                %.2f microsec", dt );
       printf( "\n   Time range                  [ %.2f .. %.2f | .. %.2f ] sec", To, Tt, Tx );
     }
+    {
+      printf( "\n\n TEST FOR LOOKAHEAD GRID " );
+      Real G[ std::size( LOOKAHEAD ) ];
+      const Time Tt{ X.grid( G ) };
+      bool ok{ true };
+      for( auto j: RANGE{ unsigned( std::size( LOOKAHEAD ) ) } ){
+        if( not ( fabs( G[j] - X( Tt + LOOKAHEAD[j] ) ) <= 1.0e-9 ) ) ok = false;
+      }
+      printf( ok ? " [ok]" : " [failed]" );
+      if( not ok ) correct = false;
+    }
+    {
+      printf( "\n\n TEST FOR RING ORDER AFTER WRAP-AROUND " );
+                                                                                                                              /*
+      Queue of 4 samples overwritten 2.5 times: the oldest sample is at `pos`, not at 0:
+                                                                                                                              */
+      auto f{ Dynamic( 4, Chebyshev2 ) };
+      for( auto i: RANGE{ 10 } ) f.update( Time( i ), 1.0*i );
+      f.process();
+      const auto[ Q, To, Tt, Tx ] = f.def();
+      Dynamic< 2 >::Sample R[4];
+      bool ok{ f.samples( R ) == 4 and To == 6.0 and Tt == 9.0 and fabs( f( 10.0 ) - 10.0 ) <= 1.0e-9 };
+      for( auto i: RANGE{ 4 } ) if( R[i].t != Time( 6 + i ) ) ok = false;
+      printf( ok ? " [ok]" : " [failed]" );
+      if( not ok ) correct = false;
+    }
     printf( "\n\n POINT COORDINATES APPROXIMATION & EXTRAPOLATION:\n"  );
     printf( "\n   %2s %6s | %7s %7s %7s | %7s %7s %7s | %7s", "#", "time", "x  ", "y  ","r  ", "x  ", "y  ", "r  ", "dev  " );
     Real maxDeviation{ 0.0 };
@@ -238,6 +363,603 @@ int main(){
     }
   }
 
+  {
+    printf( "\n\n TEST FOR POLYNOMIAL ALGEBRA " );
+    constexpr Polynomial< 2 > a{ 1.0, -1.0 };                       // :x - 1
+    constexpr Polynomial< 2 > b{ 1.0,  1.0 };                       // :x + 1
+    constexpr Polynomial< 3 > c{ a*b };                             // :x^2 - 1
+    static_assert( c[0] == 1.0 and c[1] == 0.0 and c[2] == -1.0 );
+    constexpr Polynomial< 3 > d{ c.compose( 2.0, 1.0 ) };           // :( 2x + 1 )^2 - 1 = 4x^2 + 4x
+    static_assert( d[0] == 4.0 and d[1] == 4.0 and d[2] ==  0.0 );
+    constexpr Polynomial< 3 > e{ c.shift( -1.0 ) };                 // :( x - 1 )^2 - 1 = x^2 - 2x
+    static_assert( e[0] == 1.0 and e[1] == -2.0 and e[2] == 0.0 );
+    bool ok{ true };
+    const Polynomial< 5 > p{ 0.5, -1.0, 2.0, 3.0, -4.0 };
+    Real T[5];
+    p.toChebyshev( T );
+    const auto q{ Polynomial< 5 >::fromChebyshev( T ) };
+    for( auto i: RANGE{ 5u } ) if( not ( fabs( p[i] - q[i] ) <= 1.0e-12 ) ) ok = false;
+    const Real Tk[]{ 0.0, 0.0, 0.0, 0.0, 1.0 };                     // :T_4 = 8x^4 - 8x^2 + 1
+    const auto t4{ Polynomial< 5 >::fromChebyshev( Tk ) };
+    if( t4[0] != 8.0 or t4[1] != 0.0 or t4[2] != -8.0 or t4[3] != 0.0 or t4[4] != 1.0 ) ok = false;
+    auto z = Dynamic( 11, Chebyshev4 );
+    for( auto k: RANGE{ 11 } ){ const Time t{ 100.0 + 0.1*k }; z.update( t, ( t - 100.0 )*( t - 101.0 ) ); }
+    z.process();
+    const auto[ Z, Tt ] = z.local();
+    for( const Time s: { -0.5, 0.0, 0.3 } ) if( not ( fabs( Z( s ) - z( Tt + s ) ) <= 1.0e-9 ) ) ok = false;
+    printf( ok ? " [ok]\n" : " [failed]\n" );
+    if( not ok ) correct = false;
+
+    printf( "\n\n TEST FOR ROOTS AND EXTREMA " );
+    constexpr Polynomial< 4 > w{ 1.0, 0.0, -1.0, 0.0 };            // :x^3 - x = x( x - 1 )( x + 1 )
+    Real x[3];
+    ok = w.roots( -2.0, 2.0, x ) == 3;
+    if( not ( fabs( x[0] + 1.0 ) <= 1.0e-12 and fabs( x[1] ) <= 1.0e-12 and fabs( x[2] - 1.0 ) <= 1.0e-12 ) ) ok = false;
+    const Time t1{ z.crossing( 0.0, 100.5, 102.0 ) };               // :( t - 100 )( t - 101 ) = 0
+    if( not ( fabs( t1 - 101.0 ) <= 1.0e-9 ) ) ok = false;
+    const Time t2{ z.crossing( 2.0, 100.0, 102.0 ) };               // :( t - 100 )( t - 101 ) = 2 => t = 102
+    if( not ( fabs( t2 - 102.0 ) <= 1.0e-9 ) ) ok = false;
+    if( not std::isnan( z.crossing( -1.0, 100.0, 102.0 ) ) ) ok = false;
+    const auto[ tmin, vmin, tmax, vmax ] = z.extrema( 100.0, 101.5 );
+    if( not ( fabs( tmin - 100.5 ) <= 1.0e-6 and fabs( vmin + 0.25 ) <= 1.0e-9 ) ) ok = false;
+    if( not ( fabs( tmax - 101.5 ) <= 1.0e-9 and fabs( vmax - 0.75 ) <= 1.0e-9 ) ) ok = false;
+    if( not z.within( -0.3, 0.8, 100.0, 101.5 ) or z.within( -0.2, 0.8, 100.0, 101.5 ) ) ok = false;
+                                                                                                                              /*
+    Degenerate polynomials: identically zero, zero leading coefficients; constant fit of single sample:
+                                                                                                                              */
+    constexpr Polynomial< 4 > zero{ 0.0, 0.0, 0.0, 0.0 };
+    constexpr Polynomial< 4 > line{ 0.0, 0.0, 2.0, -1.0 };           // :2x - 1
+    if( zero.roots( -1.0, 1.0, x ) != 0 ) ok = false;
+    if( not ( line.roots( -1.0, 1.0, x ) == 1 and x[0] == 0.5 ) ) ok = false;
+    const auto[ xa, pa, xb, pb ] = line.extrema( -1.0, 1.0 );
+    if( not ( xa == -1.0 and pa == -3.0 and xb == 1.0 and pb == 1.0 ) ) ok = false;
+    auto k{ Dynamic( 4, Chebyshev4 ) };
+    k.update( 1.0, 3.0 );
+    if( not ( k.crossing( 3.0, 0.0, 2.0 ) == 0.0 and std::isnan( k.crossing( 4.0, 0.0, 2.0 ) ) ) ) ok = false;
+    const auto[ tc, vc, td, vd ] = k.extrema( 0.0, 2.0 );
+    if( not ( vc == 3.0 and vd == 3.0 ) ) ok = false;
+    k.clear();
+    for( auto i: RANGE{ 4u } ) k.update( Time( i ), 1.0 + 2.0*i );   // :linear fit, leading coefficients about zero
+    k.process();
+    if( not ( fabs( k.crossing( 4.0, 0.0, 3.0 ) - 1.5 ) <= 1.0e-9 ) ) ok = false;
+    printf( ok ? " [ok]\n" : " [failed]\n" );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST: WARM START ON SLIDING WINDOW\n" );
+    constexpr unsigned L{ 11 };
+    auto cold{ Dynamic( L, Chebyshev6 ) };
+    auto warm{ Dynamic( L, Chebyshev6 ) };
+    warm.warmStart( true );
+    auto u = []( const Time& t )->Real{ return 10.0*sin( 0.15*t ) + 0.01*t*t; };
+    unsigned Nc{ 0 }, Nw{ 0 }, Nf{ 0 };
+    Time     Tc{ 0.0 }, Tw{ 0.0 };                                        // :time of fits, microsec
+    Real maxDeviation{ 0.0 };
+    for( auto i: RANGE{ 100 } ){
+      const Time t{ 0.1*i + 0.002*sin( 1.7*i ) }; // :irregular sampling
+      cold.update( t, u( t ) );
+      warm.update( t, u( t ) );
+      if( cold.length() < L ) continue;
+      auto[ nc, ec, cc, dc ] = cold.process();
+      auto[ nw, ew, cw, dw ] = warm.process();
+      Nc += nc, Nw += nw, Nf++;
+      Tc += dc, Tw += dw;
+      for( const Time dt: { -0.5, 0.0, 0.5 } ) maxDeviation = std::max( maxDeviation, fabs( cold( t + dt ) - warm( t + dt ) ) );
+    }
+    printf( "\n   Average number of rotations: cold start %.1f, warm start %.1f", double( Nc )/Nf, double( Nw )/Nf );
+    printf( "\n   Average time of fit, microsec: cold start %.2f, warm start %.2f", Tc/Nf, Tw/Nf );
+    printf( "\n   Max deviation of warm start result %.3e", maxDeviation );
+    const bool ok{ maxDeviation <= 1.0e-6 and Nw < Nc };                  // :timing printed only, not asserted
+    printf( "\n\n Test result: %s\n", ok ? "CORRECT" : "FAILURE" );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST: FITTING BY POLYNOMIALS ORTHOGONAL OVER SAMPLES\n" );
+    constexpr unsigned L{ 11 };
+    auto spectral{ Dynamic( L, Chebyshev6 ) };
+    auto forsythe{ Dynamic( L, Chebyshev6 ) };
+    forsythe.fitting( Fitting::FORSYTHE );
+    auto u = []( const Time& t )->Real{ return 10.0*cos( 0.157*t ); };
+    for( auto i: RANGE{ L } ){
+      const Time t{ Time( i ) };
+      spectral.update( t, u( t ) );
+      forsythe.update( t, u( t ) );
+    }
+    auto[ Ns, Es, Cs, ds ] = spectral.process();
+    auto[ Nf, Ef, Cf, df ] = forsythe.process();
+    Real maxDeviation{ 0.0 };
+    for( auto i: RANGE{ 15 } ) maxDeviation = std::max( maxDeviation, fabs( spectral( Time( i ) ) - forsythe( Time( i ) ) ) );
+    printf( "\n   Spectral: %u polynomials, %.2f microsec", Es, ds );
+    printf( "\n   Forsythe: %u polynomials, %.2f microsec", Ef, df );
+    printf( "\n   Max deviation %.3e", maxDeviation );
+    const bool ok{ Ef == 6 and maxDeviation <= 1.0e-6 };
+    printf( "\n\n Test result: %s\n", ok ? "CORRECT" : "FAILURE" );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR CHEBYSHEV BASIS AND SERIES " );
+    constexpr auto T12{ ChebyshevBasis< 12 >() };
+    static_assert( T12[11][0] == 1024.0 and T12[11][2] == -2816.0 and T12[11][10] == -11.0 );  // :T_11
+    static_assert( Chebyshev6[5][0] == 16.0 and Chebyshev6[5][2] == -20.0 and Chebyshev6[5][5] == 0.0 );
+    bool ok{ true };
+    for( const Real theta: { 0.1, 0.7, 2.0 } ) if( not ( fabs( T12[11]( cos( theta ) ) - cos( 11.0*theta ) ) <= 1.0e-12 ) ) ok = false;
+    constexpr unsigned L{ 40 };
+    static constexpr auto Chebyshev10{ ChebyshevBasis< 10 >() };
+    auto f{ Dynamic( L, Chebyshev10 ) };
+    f.fitting( Fitting::FORSYTHE );
+    for( auto i: RANGE{ L } ){ const Time t{ 0.05*i }; f.update( t, exp( -t ) ); }
+    f.process();
+    Real before[ 21 ];
+    for( auto i: RANGE{ 21 } ) before[i] = f( 0.1*i );
+    constexpr Real TOLERANCE{ 1.0e-5 };
+    f.truncation( TOLERANCE );
+    const auto[ S, To, Tt, Tx ] = f.series();
+    Real maxDeviation{ 0.0 };
+    for( auto i: RANGE{ 21 } ) maxDeviation = std::max( maxDeviation, fabs( f( 0.1*i ) - before[i] ) );
+    if( not ( S.length() < 10 and maxDeviation <= TOLERANCE ) ) ok = false;
+    const auto[ P, to, tt, tx ] = f.def(); // :published approximation is the truncated one
+    for( auto i: RANGE{ 21 } ) if( not ( fabs( P( 2.0*( 0.1*i - to )/( tx - to ) - 1.0 ) - f( 0.1*i ) ) <= 1.0e-12 ) ) ok = false;
+    f.truncation( 0.0 );
+    for( auto i: RANGE{ 21 } ) if( not ( fabs( f( 0.1*i ) - before[i] ) <= 1.0e-12 ) ) ok = false;
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %u of 10 Chebyshev coefficients used, max deviation %.2e\n", S.length(), maxDeviation );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR RATE-ADAPTIVE INGEST " );
+                                                                                                                              /*
+    Sensor bursts from 100 Hz to 10 kHz; window 1 sec aggregated into 10 millisec buckets:
+                                                                                                                              */
+    constexpr unsigned L{ 128 };
+    auto f{ Dynamic( L, Chebyshev3 ) };
+    f.decimation( 1.0, 0.01 );
+    auto u = []( const Time& t )->Real{ return 2.0*t - 0.5*t*t; };
+    Time t{ 0.0 };
+    for( ; t < 2.0;  t += 0.01   ) f.update( t, u( t ) );
+    for( ; t < 3.0;  t += 0.0001 ) f.update( t, u( t ) );
+    f.process();
+    const auto[ Q, To, Tt, Tx ] = f.def();
+    bool ok{ f.length() <= L and fabs( ( Tt - To ) - 1.0 ) <= 0.011 };
+    for( const Time s: { 2.2, 2.5, 2.9 } ) if( not ( fabs( f( s ) - u( s ) ) <= 1.0e-4 ) ) ok = false; // :bucket averaging error
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %u samples cover [ %.3f .. %.3f ] sec\n", f.length(), To, Tt );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR REGISTRY OF CHANNELS " );
+                                                                                                                              /*
+    Sensors identified by number; sensor `id` produces linear signal with slope `id`:
+                                                                                                                              */
+    constexpr unsigned L{ 8    };
+    constexpr unsigned K{ 1000 };
+    Registry< unsigned, Dynamic< 2 > > R( L, Chebyshev2, 16 );
+    bool ok{ R.shards() == 16 };
+    for( auto i: RANGE{ 4u } ) for( auto id: RANGE{ K } ) R.route( id, Time( i ), Real( id )*i );
+    if( R.size() != K ) ok = false;
+    unsigned processed{ 0 };
+    for( auto k: RANGE{ R.shards() } ) processed += R.process( k );
+    if( processed != K ) ok = false;
+    for( auto k: RANGE{ R.shards() } ) if( R.process( k ) != 0 ) ok = false; // :nothing dirty anymore
+    for( auto id: { 0u, 1u, 17u, 999u } ){
+      const auto D{ R.find( id ) };
+      if( not ( D and fabs( (*D)( 5.0 ) - 5.0*id ) <= 1.0e-6*( 1 + id ) ) ) ok = false;
+    }
+    if( R.find( K ) ) ok = false;
+    R.route( 17u, 4.0, 68.0 );
+    unsigned dirty{ 0 };
+    for( auto k: RANGE{ R.shards() } ) dirty += R.dirty( k, [&]( const unsigned& id, Dynamic< 2 >& D ){
+      if( not ( id == 17 and D.length() == 5 ) ) ok = false;
+    });
+    if( dirty != 1 ) ok = false;
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %zu channels in %u shards\n", R.size(), R.shards() );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR SHARED MEMORY PUBLICATION " );
+                                                                                                                              /*
+    Two channels publish into slots of the segment; subscriber maps the segment as other process does:
+                                                                                                                              */
+    constexpr unsigned L{ 11 };
+    const std::string  NAME{ "/CoreAGI.dynamic." + std::to_string( getpid() ) };
+    bool ok{ true };
+    bool crash{ true };
+    bool reopen{ true };
+    bool alive{ true };
+    try {
+      auto f{ Dynamic( L, Chebyshev4 ) };
+      auto g{ Dynamic( L, Chebyshev4 ) };
+      Subscription< 4 > subscription( [&]{
+        Publication< 4 > publication( NAME, 2 );
+        f.publisher( publication.publisher( 0 ) );
+        g.publisher( publication.publisher( 1 ) );
+        return NAME;
+      }() );
+      if( not std::isnan( subscription( 0, 1.0 ) ) ) ok = false; // :nothing published yet
+      if( std::get< 0 >( subscription.def( 1 ) ).defined() ) ok = false;
+      for( auto i: RANGE{ L } ){
+        f.update( Time( i ), 1.0 + 0.5*i );
+        g.update( Time( i ), 0.1*i*i );
+      }
+      f.process(); // :publication is destroyed, publishers keep the segment mapped
+      g.process();
+      for( const Time t: { 0.0, 5.0, 12.0 } ){
+        if( not ( fabs( subscription( 0, t ) - f( t ) ) <= 1.0e-9 ) ) alive = false;
+        if( not ( fabs( subscription( 1, t ) - g( t ) ) <= 1.0e-9 ) ) alive = false;
+      }
+      const auto[ P, To, Tt, Tx ] = subscription.def( 1 );
+      if( not ( P.defined() and To == 0.0 and Tt == L-1 ) ) ok = false;
+                                                                                                                              /*
+      Writer crashed in the middle of slot 0: reader fails promptly instead of spinning:
+                                                                                                                              */
+      using Slot = SharedMemory::Slot< 4, double >;
+      const std::size_t size{ SharedMemory::offset() + 2*sizeof( Slot ) };
+      const int fd{ shm_open( NAME.c_str(), O_RDWR, 0 ) };
+      void* base{ mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) };
+      close( fd );
+      if( base == MAP_FAILED ) throw std::runtime_error( "Shared memory segment can not be mapped: " + NAME );
+      Slot& S0{ reinterpret_cast< Slot* >( static_cast< char* >( base ) + SharedMemory::offset() )[0] };
+      S0.seq.fetch_add( 1 );
+      if( not std::isnan( subscription( 0, 1.0 ) ) ) crash = false;
+      if( std::get< 0 >( subscription.def( 0 ) ).defined() ) crash = false;
+      if( not ( fabs( subscription( 1, 5.0 ) - g( 5.0 ) ) <= 1.0e-9 ) ) crash = false;
+                                                                                                                              /*
+      Restarted writer reopens the segment: header and slot 1 kept, torn slot 0 reset, then published again;
+      other layout is refused:
+                                                                                                                              */
+      Publication< 4 > publication( NAME, 2 );
+      if( S0.seq.load() != 0 ) reopen = false;
+      if( not ( fabs( subscription( 1, 5.0 ) - g( 5.0 ) ) <= 1.0e-9 ) ) reopen = false;
+      f.publisher( publication.publisher( 0 ) );
+      f.update( Time( L ), 1.0 + 0.5*L );
+      f.process();
+      if( not ( fabs( subscription( 0, 12.0 ) - f( 12.0 ) ) <= 1.0e-9 ) ) reopen = false;
+      munmap( base, size );
+      try { Publication< 3 > other( NAME, 2 ); reopen = false; } catch( const std::runtime_error& ){}
+      try { Publication< 4 > other( NAME, 3 ); reopen = false; } catch( const std::runtime_error& ){}
+      if( not ( fabs( subscription( 1, 5.0 ) - g( 5.0 ) ) <= 1.0e-9 ) ) reopen = false;
+      publication.remove();
+    } catch( const std::exception& e ){
+      printf( " %s", e.what() );
+      ok = false;
+    }
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " slots evaluated in mapped memory\n" );
+    printf( alive ? " [ok]" : " [failed]" );
+    printf( " publishers outlive publication\n" );
+    printf( crash ? " [ok]" : " [failed]" );
+    printf( " slot torn by crashed writer read as undefined\n" );
+    printf( reopen ? " [ok]" : " [failed]" );
+    printf( " reopened segment validated, torn slot reset\n" );
+    if( not ( ok and alive and crash and reopen ) ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR CHECKPOINT AND RESTORE " );
+                                                                                                                              /*
+    Registry saved incrementally, restored by other registry as after restart:
+                                                                                                                              */
+    constexpr unsigned L{ 8   };
+    constexpr unsigned K{ 300 };
+    const std::string  PATH{ "/tmp/CoreAGI.dynamic." + std::to_string( getpid() ) + ".checkpoint" };
+    bool ok{ true };
+    try {
+      Registry< unsigned, Dynamic< 3 > > R( L, Chebyshev3, 8 );
+      for( auto i: RANGE{ 12u } ) for( auto id: RANGE{ K } ) R.route( id, Time( i ), Real( id ) + 0.01*i*i );
+      for( auto k: RANGE{ R.shards() } ) R.process( k );
+      Checkpoint< 3, Real, unsigned > C( PATH, L );
+      if( R.save( C ) != K ) ok = false;
+      if( R.save( C ) != 0 ) ok = false;                                  // :nothing changed
+      R.route( 7u, 12.0, 7.0 + 1.44 );
+      R[ 7u ].process();
+      if( R.save( C ) != 1 ) ok = false;                                  // :only updated channel written
+      C.sync();
+      Registry< unsigned, Dynamic< 3 > > Q( L, Chebyshev3, 4 );
+      Snapshot< 3, Real, unsigned > S( PATH );
+      if( not ( Q.load( S ) == K and Q.size() == K ) ) ok = false;
+      for( auto id: { 0u, 7u, 123u, K-1 } ){
+        auto& D{ Q[ id ] };
+        if( not ( D.defined() and D.length() == L and not D.mutant.load() ) ) ok = false;
+        if( not ( fabs( D( 13.0 ) - (*R.find( id ))( 13.0 ) ) <= 1.0e-12 ) ) ok = false;
+      }
+      Q.route( 7u, 13.0, 7.0 + 1.69 );                                    // :restored channel continues
+      Q[ 7u ].process();
+      if( not ( fabs( Q[ 7u ]( 14.0 ) - ( 7.0 + 1.96 ) ) <= 1.0e-9 ) ) ok = false;
+                                                                                                                              /*
+      Load into registry that already has channels: new key holds serial 0 used by the snapshot, existing key
+      7 holds serial 1; after full save every key has exactly one record:
+                                                                                                                              */
+      Registry< unsigned, Dynamic< 3 > > U( L, Chebyshev3, 4 );
+      U.route( K, 0.0, 1.0 );
+      U.route( 7u, 0.0, 1.0 );
+      if( not ( U.load( S ) == K and U.size() == K + 1 ) ) ok = false;
+      U.save( C, true );
+      C.sync();
+      Snapshot< 3, Real, unsigned > T( PATH );
+      unsigned records{ 0 };
+      for( auto i: RANGE{ T.count() } ) if( T.valid( i ) ) records++;
+      Registry< unsigned, Dynamic< 3 > > V( L, Chebyshev3, 4 );
+      if( not ( records == K + 1 and V.load( T ) == K + 1 and V.size() == K + 1 and V.find( K ) ) ) ok = false;
+      if( not ( fabs( V[ 7u ]( 13.0 ) - (*R.find( 7u ))( 13.0 ) ) <= 1.0e-12 ) ) ok = false;
+                                                                                                                              /*
+      Record torn by crash (part of the body not written) is ignored: channel 2 saved twice (by `R` and `U`)
+      is restored from the previous record when the newest one (slot 0) is torn, and is lost when both are:
+                                                                                                                              */
+      constexpr std::size_t STRIDE{ CheckpointFile::stride< 3, Real, unsigned, Dynamic< 3 >::Sample >( L ) };
+      const char torn[ 16 ]{};
+      auto tear = [&]( unsigned b ){
+        const int  fd{ open( PATH.c_str(), O_WRONLY ) };
+        const bool written{ pwrite( fd, torn, sizeof( torn ), off_t( C.OFFSET + ( 2*2 + b )*STRIDE + 64 ) ) == ssize_t( sizeof( torn ) ) };
+        close( fd );
+        return written;
+      };
+      if( not tear( 0 ) ) ok = false;
+      Snapshot< 3, Real, unsigned > W( PATH );
+      Registry< unsigned, Dynamic< 3 > > Y( L, Chebyshev3, 4 );
+      if( not ( W.valid( 2 ) and Y.load( W ) == K + 1 ) ) ok = false;
+      if( not ( fabs( Y[ 2u ]( 13.0 ) - (*R.find( 2u ))( 13.0 ) ) <= 1.0e-12 ) ) ok = false;
+      if( not tear( 1 ) ) ok = false;
+      Snapshot< 3, Real, unsigned > Z( PATH );
+      Registry< unsigned, Dynamic< 3 > > X( L, Chebyshev3, 4 );
+      if( not ( not Z.valid( 2 ) and Z.valid( 3 ) and X.load( Z ) == K and not X.find( 2u ) ) ) ok = false;
+                                                                                                                              /*
+      Channel with fewer samples than the record holds leaves no samples of the previous channel written
+      in the tail; approximation not fitted to the saved samples is refitted after restore:
+                                                                                                                              */
+      Dynamic< 3 > a( L, Chebyshev3 ), b( L, Chebyshev3 ), c( L, Chebyshev3 );
+      for( auto i: RANGE{ L } ) a.update( Time( i ), 1.0 );
+      for( auto i: RANGE{ 3u } ) b.update( Time( i ), Real( i ) );
+      b.process();
+      b.update( 3.0, 3.0 );
+      if( not ( C.save( 0, 0u, a ) and C.save( 1, 1u, b ) ) ) ok = false;
+      std::vector< char > record( STRIDE );
+      const int fd{ open( PATH.c_str(), O_RDONLY ) };
+      if( pread( fd, record.data(), STRIDE, off_t( C.OFFSET + ( 2*1 + 0 )*STRIDE ) ) != ssize_t( STRIDE ) ) ok = false;
+      close( fd );
+      const std::size_t end{ sizeof( CheckpointFile::Record< 3, Real, unsigned > ) + 4*sizeof( Dynamic< 3 >::Sample ) };
+      for( auto k: RANGE{ end, STRIDE - sizeof( std::uint64_t ) } ) if( record[k] != 0 ) ok = false;
+      Snapshot< 3, Real, unsigned > V1( PATH );
+      if( not ( V1.load( 1, c ) and c.length() == 4 and c.mutant.load() ) ) ok = false;
+      c.process();
+      if( not ( fabs( c( 4.0 ) - 4.0 ) <= 1.0e-9 ) ) ok = false;
+    } catch( const std::exception& e ){
+      printf( " %s", e.what() );
+      ok = false;
+    }
+    unlink( PATH.c_str() );
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %u channels restored\n", K );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR CYCLE COUNTER TIMER AND TRACE ZONES " );
+    bool ok{ true };
+    Trace::clear();
+    double ms;
+    {
+      const Trace::Zone zone( "sleep" );
+      CycleTimer cycles;
+      Timer      timer;
+      CoreAGI::sleep( 10 );
+      ms = cycles.elapsed( Timer::MILLISEC );
+      if( not ( fabs( ms - timer.elapsed( Timer::MILLISEC ) ) <= 0.5 ) ) ok = false;
+    }
+    FILE* file{ tmpfile() };
+    if( not ( file and Trace::dump( file ) == 1 ) ) ok = false;
+    if( file ) fclose( file );
+    const unsigned held{ Trace::buffers() };
+    std::thread( []{ const Trace::Zone zone( "thread" ); } ).join();
+    if( Trace::buffers() != held + 1 ) ok = false; // :buffer of exited thread kept for dump
+    Trace::clear();
+    if( Trace::buffers() != held ) ok = false;     // :and released by clear
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %.3f millisec, %.4f nanosec per tick\n", ms, Cycles::nanosec() );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR AWAITING THE NEXT APPROXIMATION " );
+    constexpr unsigned L{ 11 };
+    auto f{ Dynamic( L, Chebyshev4 ) };
+    auto g{ Dynamic( L, Chebyshev4 ) };
+    for( auto i: RANGE{ L } ){ f.update( Time( i ), 1.0*i ); g.update( Time( i ), 2.0*i ); }
+    std::vector< Time > F, G;
+    consume( f, 2, F );
+    consume( g, 1, G );
+    bool ok{ F.empty() and G.empty() };                                   // :both suspended
+    f.process();
+    if( not ( F.size() == 1 and F[0] == L-1 ) ) ok = false;               // :resumed by `process`
+    {
+      FitBatch batch;                                                     // :wakeups deferred to the end of scope
+      f.update( Time( L ), 1.0*L );
+      f.process();
+      g.process();
+      if( not ( F.size() == 1 and G.empty() and batch.size() == 2 ) ) ok = false;
+    }
+    if( not ( F.size() == 2 and F[1] == L and G.size() == 1 ) ) ok = false;
+                                                                                                                              /*
+    Blocking wait of other thread:
+                                                                                                                              */
+    const std::uint64_t seen{ f.epoch() };
+    std::uint64_t       woken{ seen };
+    std::thread waiter( [&]{ woken = f.wait( seen ); } );
+    f.update( Time( L+1 ), 1.0*( L+1 ) );
+    f.process();
+    waiter.join();
+    if( woken != seen + 1 ) ok = false;
+                                                                                                                              /*
+    Resumed coroutine uses the channel that resumed it (locks of the channel are released before resumption):
+                                                                                                                              */
+    std::vector< Time > H;
+    refit( f, H );
+    f.update( Time( L+2 ), 1.0*( L+2 ) );
+    f.process();
+    if( not ( H.size() == 2 and H[0] == L+2 and H[1] == L+3 ) ) ok = false;
+                                                                                                                              /*
+    Coroutine awaiting moved-from channel is not resumed by the move, nor by the moved channel, but by
+    destruction of the moved-from one, with no approximation:
+                                                                                                                              */
+    std::vector< Time > M;
+    {
+      auto e{ Dynamic( L, Chebyshev4 ) };
+      for( auto i: RANGE{ L } ) e.update( Time( i ), 2.0*i );
+      consume( e, 1, M );
+      auto h{ std::move( e ) };
+      if( not M.empty() ) ok = false;
+      h.process();
+      if( not M.empty() or std::get< 2 >( h.def() ) != L-1 ) ok = false;
+    }
+    if( not ( M.size() == 1 and std::isnan( M[0] ) ) ) ok = false;
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %zu + %zu approximations awaited\n", F.size(), G.size() );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR MULTI-RESOLUTION PYRAMID " );
+                                                                                                                              /*
+    Three levels of 16 samples decimated by 8: level 0 covers 0.15 sec, level 1 covers 1.2 sec, level 2
+    covers 9.6 sec of samples taken each 10 millisec:
+                                                                                                                              */
+    DynamicPyramid< 3 > pyramid( 3, 16, 8, Chebyshev3 );
+    auto u = []( const Time& t )->Real{ return 1.0 + 0.3*t - 0.02*t*t; };
+    unsigned fits[3]{ 0, 0, 0 };
+    Time t{ 0.0 };
+    for( auto i: RANGE{ 1200 } ){
+      t = 0.01*i;
+      pyramid.update( t, u( t ) );
+      const unsigned n{ pyramid.process() };
+      for( auto k: RANGE{ n } ) fits[k]++;                                // :fitted levels are the finest ones
+    }
+    bool ok{ pyramid.level( t + 0.05 ) == 0 and pyramid.level( t + 0.5 ) == 1 and pyramid.level( t + 3.0 ) == 2 };
+    if( not ( fits[0] == 1200 and fits[1] == 1200/8 and fits[2] == 1200/64 ) ) ok = false;
+    for( const Time s: { 0.05, 0.5, 3.0 } ) if( not ( fabs( pyramid( t + s ) - u( t + s ) ) <= 1.0e-3 ) ) ok = false;
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " fits per level %u %u %u\n", fits[0], fits[1], fits[2] );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR PARALLEL ORDERING JACOBI " );
+                                                                                                                              /*
+    Gram matrix of 16 monomials over 64 points (condition number about 1e12), solved with both orderings:
+                                                                                                                              */
+    constexpr unsigned M{ 16 };
+    Real G[M][M];
+    for( auto i: RANGE{ M } ) for( auto j: RANGE{ M } ){
+      Real s{ 0.0 };
+      for( auto k: RANGE{ 64u } ) s += pow( -1.0 + k/31.5, i + j );
+      G[i][j] = s;
+    }
+    Eigen< M, Real > cyclic, parallel;
+    cyclic  .ordering( Ordering::CYCLIC   );
+    parallel.ordering( Ordering::PARALLEL );
+    for( auto i: RANGE{ M } ) for( auto j: RANGE{ i+1 } ){ cyclic.let( i, j, G[i][j] ); parallel.let( i, j, G[i][j] ); }
+    bool ok{ cyclic.run() and parallel.run() };
+    cyclic.sort();
+    parallel.sort();
+    Real maxResidual{ 0.0 };
+    for( auto k: RANGE{ M } ){
+      const Real lambda{ parallel.eigenValue( k ) };
+      if( not ( fabs( lambda - cyclic.eigenValue( k ) ) <= 1.0e-9*cyclic.eigenValue( 0 ) ) ) ok = false;
+      Real e[M];
+      parallel.eigenVector( e, k );
+      for( auto i: RANGE{ M } ){
+        Real r{ -lambda*e[i] };
+        for( auto j: RANGE{ M } ) r += G[i][j]*e[j];
+        maxResidual = std::max( maxResidual, fabs( r ) );
+      }
+    }
+    if( not ( maxResidual <= 1.0e-9*cyclic.eigenValue( 0 ) ) ) ok = false;
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " rotations %u cyclic, %u parallel; max residual %.2e\n",
+      cyclic.rotationNumber(), parallel.rotationNumber(), maxResidual );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR OUT-OF-ORDER INGEST " );
+                                                                                                                              /*
+    Samples of quadratic come reversed in blocks of 4, time 8 comes thrice (values merged into exact one),
+    time 5 comes after the window passed it:
+                                                                                                                              */
+    Dynamic< 3 > f( 16, Chebyshev3 );
+    f.reorder( 4 );
+    auto u = []( const Time& t )->Real{ return 2.0 - 0.5*t + 0.03*t*t; };
+    for( auto i: RANGE{ 40u } ){
+      const Time t( ( i/4 )*4 + 3 - i%4 );
+      f.update( t, u( t ) );
+      if( t == 8.0 ){ f.update( t, u( t ) + 0.25 ); f.update( t, u( t ) - 0.25 ); }
+    }
+    f.update( 5.0, u( 5.0 ) );
+    Dynamic< 3 >::Sample R[16];
+    bool ok{ f.samples( R ) == 16 and R[15].t == 35.0 };                         // :4 the newest samples still wait
+    ok = f.flush() == 16 and f.late() == 1 and ok;
+    const unsigned n{ f.samples( R ) };
+    for( auto i: RANGE{ n } ){
+      if( R[i].t != Time( 24 + i ) or fabs( R[i].v - u( R[i].t ) ) > 1.0e-12 ) ok = false;
+    }
+    f.process();
+    for( const Time t: { 30.0, 39.0, 45.0 } ) if( not ( fabs( f( t ) - u( t ) ) <= 1.0e-9 ) ) ok = false;
+    Dynamic< 3 > g( 16, Chebyshev3 );
+    g.reorder( 4 );
+    for( const Time t: { 2.0, 1.0, 1.0, 3.0 } ) g.update( t, u( t ) );
+    g.flush();
+    Dynamic< 3 >::Sample D[16];
+    ok = g.samples( D ) == 3 and D[0].t == 1.0 and D[0].w == 2.0 and ok;     // :duplicates merged, weights summed
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %u samples, %lu late\n", n, f.late() );
+    if( not ok ) correct = false;
+  }
+
+  {
+    printf( "\n\n TEST FOR SINGLE SAMPLE AFTER CLEAR " );
+                                                                                                                              /*
+    `process` that copied empty queue after `clear` publishes undefined approximation after the single sample
+    published constant; the sample must stay marked as not fitted, so the next `process` restores constant:
+                                                                                                                              */
+    Dynamic< 3 > f( 8, Chebyshev3 );
+    bool ok{ true };
+    unsigned undefined{ 0 };
+    for( auto i: RANGE{ 2000u } ){
+      f.clear();
+      std::thread fitter( [&]{ f.process(); } );
+      f.update( Time( i ), 1.0*i );
+      fitter.join();
+      if( not f.mutant.load() and not f.defined() ) ok = false;          // :sample lost
+      if( not f.defined() ) undefined++;
+      f.process();
+      if( not ( f.defined() and f( Time( i ) ) == 1.0*i ) ) ok = false;
+    }
+    f.clear();
+    f.process();
+    f.update( 0.0, 1.0 );
+    if( not ( f.mutant.load() and f.defined() ) ) ok = false;
+                                                                                                                              /*
+    Lookahead grid after constant (unit time range, `Tt == To`) followed by approximation of unit time range
+    with `Tt` inside it:
+                                                                                                                              */
+    constexpr Time A[]{ 0.25 };
+    f.lookahead( A );
+    f.process();
+    const Dynamic< 3 >::Sample S[]{ { 0.0, 0.0, 1.0 }, { 0.5, 0.5, 1.0 } };
+    constexpr Polynomial< 3 > p{ 0.0, 0.5, 0.5 };                       // :( x + 1 )/2 maps [ 0 .. 1 ] to itself
+    f.restore( S, 2, p, 0.0, 0.5, 1.0 );
+    Real g;
+    f.grid( &g );
+    if( not ( fabs( g - 0.75 ) <= 1.0e-12 ) ) ok = false;
+    printf( ok ? " [ok]" : " [failed]" );
+    printf( " %u outdated publications corrected\n", undefined );
+    if( not ok ) correct = false;
+  }
+
   printf( "\n Verdict: %s\n", correct ? "CORRECT" : "FAILURE" );
 
 	return correct ? EXIT_SUCCESS : EXIT_FAILURE;
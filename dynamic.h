@@ -7,80 +7,444 @@ ________________________________________________________________________________
   2021.11.16 Initial version
 
   2021.12.08 Assignment operator fixed
+
+  2026.10.18 Layout option: producer and published states placed on distinct cache lines
+
+  2026.10.18 Move operations; copies share the queue of samples until updated (copy-on-write)
+
+  2026.10.18 Lookahead grid evaluated by `process`
+
+  2026.10.18 Fixed order of samples after wrap-around of the queue: `process` reads them from the oldest one
+
+  2026.10.18 Approximation as polynomial of physical time relative to the last sample
+
+  2026.10.18 Queries: the earliest crossing of the level, extrema and bounds in the time interval
+
+  2026.10.18 Fitter state: warm start of the eigen solver, configurable tolerance, serialized `process`
+
+  2026.10.18 Fitting by polynomials orthogonal over the samples (Forsythe), no linear system solution
+
+  2026.10.18 Approximation kept in Chebyshev form too and evaluated by Clenshaw recurrence with trimmed tail
+
+  2026.10.18 Weighted samples; rate-adaptive ingest aggregating samples into time buckets within time window
+
+  2026.10.18 Queue of samples can be placed into external storage (used by the registry)
+
+  2026.10.18 Publisher: receiver of each new approximation (e.g. shared memory publication)
+
+  2026.10.18 Samples and approximation can be copied out and restored (checkpoint)
+
+  2026.10.18 Fit time measured by cycle counter; trace zones of `process`
+
+  2026.10.18 Fixed races: update concurrent with `process` lost; `defined` read without lock
+
+  2026.10.18 Waiting for the next approximation: blocking `wait` and coroutine awaiter `next_fit`
+
+  2026.10.18 Out-of-order samples: bounded reorder window, samples of the same time merged, late samples dropped
+
+  2026.10.18 Awaiting coroutines resumed with empty result by destruction, not by move
 ________________________________________________________________________________________________________________________________
                                                                                                                               */#ifndef DYNAMIC_H_INCLUDED
 #define DYNAMIC_H_INCLUDED
 
 #include <cstring> // :memset
 
+#include <algorithm> // :std::push_heap, std::pop_heap
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <thread>
+#include <vector>
 
+#include "awaitable.h"
+#include "cacheline.h"
 #include "eigen.h"
+#include "forsythe.h"
 #include "range.h"
 #include "timer.h"
+#include "trace.h"
 
 namespace CoreAGI {
 
   enum class RangePoint: unsigned { UNDEFINED = 0, BACKWARD, INSIDE, FORWARD };
+                                                                                                                              /*
+  Fitting method:
+    SPECTRAL - least squares in the functional basis, normal equations solved via eigen vectors
+    FORSYTHE - least squares by polynomials orthogonal over the samples; functional basis not used
+                                                                                                                              */
+  enum class Fitting: unsigned { SPECTRAL = 0, FORSYTHE };
+
+  template< unsigned N, typename Real = double, Layout LAYOUT = Layout::COMPACT > class Dynamic {
 
-  template< unsigned N, typename Real = double > class Dynamic {
+  public:
 
-    using Time = double;
+    using Time  = double;
+    using Value = Real;
+    using Basis = PolynomialBasis< N, Real >;
 
     struct Sample {
       Time t;
       Real v;
-      Sample( const Time& t, const Real& v ): t{  t },  v{  v  }{}
-      Sample(                              ): t{ 0.0 }, v{ 0.0 }{}
+      Real w; // :weight, number of aggregated samples
+      Sample( const Time& t, const Real& v, const Real& w = 1.0 ): t{  t },  v{  v  }, w{  w  }{}
+      Sample(                                                  ): t{ 0.0 }, v{ 0.0 }, w{ 1.0 }{}
       bool operator!= ( const Sample& S ) const { return t != S.t; }
     };
 
+    using Ring = std::shared_ptr< Sample[] >; // :queue of samples; may point into externally owned storage
+                                                                                                                              /*
+    Receiver of each new approximation `P`, `To`, `Tt`, `Tx` (e.g. slot of shared memory publication):
+                                                                                                                              */
+    using Publisher = std::function< void( const Polynomial< N, Real >&, const Time&, const Time&, const Time& ) >;
+
+  private:
+
 //  const unsigned                    CAPACITY; // :queue capacity
     unsigned                          CAPACITY; // :queue capacity
     const PolynomialBasis< N, Real >& F;        // :basis
-    Sample*                           S;        // :queue of samples
-    unsigned                          pos;      // :sample incl position
+                                                                                                                              /*
+    Producer state, written by `update` and `clear`:
+                                                                                                                              */
+    alignas( alignment< std::mutex >( LAYOUT ) )
+    mutable std::mutex                mutexQ;   // :protects S, copied, pos, len, K, REORDER, overdue
+    std::shared_ptr< Sample[] >       S;        // :queue of samples, shared by copies until updated
+    mutable bool                      copied;   // :queue may be shared with a copy; the next write detaches it
+    unsigned                          pos;      // :position of the next sample
     unsigned                          len;      // :actual number of samples
+    Time                              WINDOW;   // :time window used for approximation; 0 means whole queue
+    Time                              BUCKET;   // :width of the time bucket aggregating samples; 0 means none
+    std::vector< Sample >             K;        // :reorder buffer, heap with the earliest sample on top
+    unsigned                          REORDER;  // :capacity of the reorder buffer; 0 means samples in order
+    unsigned long                     overdue;  // :number of dropped late samples
+                                                                                                                              /*
+    Published approximation, written by `process` and read by consumers:
+                                                                                                                              */
+    alignas( alignment< std::mutex >( LAYOUT ) )
+    mutable std::mutex                mutexP;   // :protects P, Q, TRIM, To, Tt, Tx, T_, H, M, Tm, Dm, G, out
     Polynomial< N, Real >             P;        // :approximation polynomial
+    ChebyshevSeries< N, Real >        Q;        // :approximation polynomial in Chebyshev form
+    Real                              TRIM;     // :tolerance of dropping tail coefficients of Q
     Time                              To;       // :extrapolation horizon
     Time                              Tt;       // :extrapolation horizon
     Time                              Tx;       // :extrapolation horizon
     Time                              T_;       // :size of the full time range [ To .. Tx ]
-    mutable std::mutex                mutexP;   // :protects P, To, Tt, Tx, T_
-    mutable std::mutex                mutexQ;   // :protects S, len
+    std::vector< Time >               H;        // :lookahead grid, offsets relative to Tt
+    std::vector< Real >               M;        // :powers of the normalized lookahead points, row per point
+    Time                              Tm;       // :full time range used to calculate M
+    Time                              Dm;       // :time from To to Tt used to calculate M
+    std::vector< Real >               G;        // :approximated values on the lookahead grid
+    Publisher                         out;      // :receiver of new approximations; not shared by copies
+                                                                                                                              /*
+    Fitter state, written by `process`:
+                                                                                                                              */
+    alignas( alignment< std::mutex >( LAYOUT ) )
+    mutable std::mutex                mutexF;   // :serializes `process`, protects J, EPS, fit
+    std::unique_ptr< Eigen< N, Real > > J;      // :solver kept between fits for warm start
+    Real                              EPS;      // :relative convergence tolerance of the solver; 0 means default test
+    Fitting                           fit;      // :fitting method
+                                                                                                                              /*
+    Notification of consumers, written after each publication of approximation:
+                                                                                                                              */
+    alignas( alignment< std::atomic< std::uint64_t > >( LAYOUT ) )
+    std::atomic< std::uint64_t >      published; // :number of published approximations (epoch)
+    mutable Waiters                   waiters;   // :coroutines awaiting the next approximation
 
-  public:
+    void share( const Dynamic& D ){
+                                                                                                                              /*
+      Share queue of samples and copy approximation of `D`; caller ensures `this != &D`:
+                                                                                                                              */
+      {
+        const std::scoped_lock lock( mutexQ, D.mutexQ );
+        CAPACITY = D.CAPACITY;
+        S        = D.S;
+        copied   = D.copied = true;
+        pos      = D.pos;
+        len      = D.len;
+        WINDOW   = D.WINDOW;
+        BUCKET   = D.BUCKET;
+        K        = D.K;
+        REORDER  = D.REORDER;
+        overdue  = D.overdue;
+      }
+      {
+        const std::scoped_lock lock( mutexP, D.mutexP );
+        P  = D.P;
+        Q  = D.Q;
+        TRIM = D.TRIM;
+        To = D.To;
+        Tt = D.Tt;
+        Tx = D.Tx;
+        T_ = D.T_;
+        H  = D.H;
+        M  = D.M;
+        Tm = D.Tm;
+        Dm = D.Dm;
+        G  = D.G;
+      }
+      {
+        const std::scoped_lock lock( mutexF, D.mutexF );
+        J   = D.J ? std::make_unique< Eigen< N, Real > >( *D.J ) : nullptr;
+        EPS = D.EPS;
+        fit = D.fit;
+      }
+      mutant.store( D.mutant.load() );
+    }
+
+    void detach(){
+                                                                                                                              /*
+      Make private copy of the shared queue of samples; `mutexQ` locked by caller:
+                                                                                                                              */
+      std::shared_ptr< Sample[] > R{ std::make_shared< Sample[] >( CAPACITY ) };
+      for( auto i: RANGE{ len } ) R[i] = S[i];
+      S = std::move( R );
+      copied = false;
+    }
 
+    void own(){
+                                                                                                                              /*
+      Make the queue private before write; `mutexQ` locked by caller. Ownership is tracked by `copied` set
+      under both locks by `share` rather than by `use_count`, which is read relaxed and gives no happens-before
+      with reads of the queue by a copy that was destroyed meanwhile. Moved-from object gets a new queue:
+                                                                                                                              */
+      if( not S ){
+        S      = std::make_shared< Sample[] >( CAPACITY );
+        pos    = 0;
+        len    = 0;
+        copied = false;
+      } else if( copied ) detach();
+    }
+
+    void append( const Sample& s ){
+                                                                                                                              /*
+      Append sample to the queue; `mutexQ` locked by caller. When time buckets defined, sample that falls
+      into the bucket of the newest sample is aggregated with it as weighted mean:
+                                                                                                                              */
+      mutant.store( true ); // :under the lock of the queue, so `state` sees flag consistent with samples
+      if( BUCKET > 0.0 and len > 0 ){
+        Sample& Sn{ S[ pos > 0 ? pos-1 : CAPACITY-1 ] }; // :the newest sample
+        if( std::floor( Sn.t/BUCKET ) == std::floor( s.t/BUCKET ) ){
+          const Real w{ Sn.w + s.w };
+          Sn.t = ( Sn.w*Sn.t + s.w*s.t )/w;
+          Sn.v = ( Sn.w*Sn.v + s.w*s.v )/w;
+          Sn.w = w;
+          return;
+        }
+      }
+                                                                                                                              /*
+      `pos` changed cyclically and always points to the next sample, so the oldest sample
+      is at position `( pos + CAPACITY - len ) % CAPACITY`:
+                                                                                                                              */
+      S[ pos ] = s;
+      if( ++pos >= CAPACITY ) pos = 0;
+      if( len < CAPACITY ) len++;
+    }
+
+    static bool later( const Sample& a, const Sample& b ){ return a.t > b.t; }
+
+    bool commit( unsigned keep ){
+                                                                                                                              /*
+      Move the earliest samples from the reorder buffer into the queue until `keep` samples left; `mutexQ`
+      locked by caller. Sample of the same time as the newest one in the queue is merged with it (weighted
+      mean of values), older one came too late and is dropped. Returns true if the queue changed:
+                                                                                                                              */
+      bool moved{ false };
+      while( K.size() > keep ){
+        std::pop_heap( K.begin(), K.end(), later );
+        const Sample s{ K.back() };
+        K.pop_back();
+        if( len > 0 ){
+          Sample& Sn{ S[ pos > 0 ? pos-1 : CAPACITY-1 ] }; // :the newest sample
+          if( s.t < Sn.t ){ overdue++; continue; }
+          if( s.t == Sn.t ){
+            const Real w{ Sn.w + s.w };
+            Sn.v = ( Sn.w*Sn.v + s.w*s.v )/w;
+            Sn.w = w;
+            mutant.store( true );
+            moved = true;
+            continue;
+          }
+        }
+        append( s );
+        moved = true;
+      }
+      return moved;
+    }
+
+    void changed( unsigned L, const Sample& last ){
+                                                                                                                              /*
+      Queue of `L` samples changed, `last` is the newest sample. `mutant` is set by the change and never reset
+      here: concurrent `process` that copied the queue before the change (e.g. empty queue after `clear`)
+      publishes outdated result, and only the next `process` corrects it. Single sample defines constant
+      immediately:
+                                                                                                                              */
+      if( L == 1 ){ constant( &last ); notify(); }
+    }
+
+    void evaluate(){
+                                                                                                                              /*
+      Calculate values on the lookahead grid as product of matrix of powers of normalized grid points and
+      vector of polynomial coefficients; `mutexP` locked by caller. Normalized points depend on the length
+      of the time range and on the position of `Tt` in it only, so matrix recalculated only when they changed
+      (both differ e.g. for constant approximation of single sample, where `Tt == To`):
+                                                                                                                              */
+      const unsigned n{ unsigned( H.size() ) };
+      if( n == 0 ) return;
+      if( T_ != Tm or Tt - To != Dm ){
+        for( auto j: RANGE{ n } ){
+          const Real x{ Real( 2.0*( Tt + H[j] - To )/T_ - 1.0 ) };
+          Real xk{ 1.0 };
+          for( unsigned k = N; k-- > 0; ){ M[ j*N + k ] = xk; xk *= x; }
+        }
+        Tm = T_;
+        Dm = Tt - To;
+      }
+      for( auto j: RANGE{ n } ){
+        const Real* Mj{ &M[ j*N ] };
+        Real g{ 0.0 };
+        for( auto k: RANGE{ N } ) g += Mj[k]*P[k];
+        G[j] = g;
+      }
+    }
+
+    void constant( const Sample* s ){
+                                                                                                                              /*
+      Publish approximation polynomial that actually represents constant value of the single sample `s`, or
+      undefined approximation if `s` is `nullptr`; unit time range keeps mapping of the time finite. Caller
+      calls `notify` when no lock is held:
+                                                                                                                              */
+      {
+        const std::lock_guard< std::mutex > lock( mutexP );
+        if( s ){
+          P  = s->v;
+          Q  = ChebyshevSeries< N, Real >( P );
+          To = s->t;
+          Tt = s->t;
+          Tx = s->t;
+        } else {
+          P.undef();
+          Q.undef();
+        }
+        T_ = 1.0;
+        evaluate();
+        if( out and s ) out( P, To, Tt, Tx );
+      }
+    }
+
+    void notify(){
+                                                                                                                              /*
+      New approximation published: wake threads blocked in `wait` and coroutines awaiting `next_fit`. No lock
+      of this object may be held by caller: resumed coroutines run here and can use the object:
+                                                                                                                              */
+      published.fetch_add( 1, std::memory_order_release );
+      published.notify_all();
+      waiters.resume();
+    }
+
+    void abandon() noexcept {
+      S.reset();
+      copied = false;
+      pos = 0;
+      len = 0;
+      K.clear();
+      P.undef();
+      Q.undef();
+      H.clear();
+      M.clear();
+      G.clear();
+      out = nullptr;
+      mutant.store( false );
+    }
+
+  public:
+                                                                                                                              /*
+    Flag written by both producer and fitter; in PADDED layout occupies its own cache line:
+                                                                                                                              */
+    alignas( alignment< std::atomic< bool > >( LAYOUT ) )
     std::atomic< bool > mutant;
 
     Dynamic( unsigned capacity, const PolynomialBasis< N, Real >& basis ):
-      CAPACITY{ capacity               },
-      F       { basis                  },
-      S       { new Sample[ CAPACITY ] },
-      pos     { 0                      },
-      len     { 0                      },
-      P{}, To{}, Tt{}, Tx{}, T_{}, mutexP{}, mutexQ{}, mutant{ false }
+      Dynamic( capacity, basis, std::make_shared< Sample[] >( capacity ) )
+    {}
+                                                                                                                              /*
+    Queue of samples placed into the given storage of `capacity` samples (e.g. slab of the registry); the
+    storage is released when the last owner of `ring` is destroyed:
+                                                                                                                              */
+    Dynamic( unsigned capacity, const PolynomialBasis< N, Real >& basis, Ring ring ):
+      CAPACITY{ capacity          },
+      F       { basis             },
+      mutexQ  {                   },
+      S       { std::move( ring ) },
+      copied  { false             },
+      pos     { 0                 },
+      len     { 0                 },
+      WINDOW  { 0.0               },
+      BUCKET  { 0.0               },
+      K       {                   },
+      REORDER { 0                 },
+      overdue { 0                 },
+      mutexP{}, P{}, Q{}, TRIM{ 0.0 }, To{}, Tt{}, Tx{}, T_{}, H{}, M{}, Tm{}, Dm{}, G{}, out{}, mutexF{}, J{}, EPS{ 0.0 }, fit{ Fitting::SPECTRAL },
+      published{ 0 }, waiters{},
+      mutant{ false }
     {
-      P.undef(); assert( not defined() );
+      P.undef(); Q.undef(); assert( not defined() );
     }
-
+                                                                                                                              /*
+    Copy is a snapshot that shares the queue of samples with the original until one of them is updated
+    (copy-on-write), so forks for "what-if" extrapolation are cheap:
+                                                                                                                              */
     Dynamic( const Dynamic& D ):
+      CAPACITY{ D.CAPACITY }, F{ D.F }, mutexQ{}, S{}, copied{ false }, pos{ 0 }, len{ 0 }, WINDOW{ 0.0 }, BUCKET{ 0.0 },
+      K{}, REORDER{ 0 }, overdue{ 0 },
+      mutexP{}, P{}, Q{}, TRIM{ 0.0 }, To{}, Tt{}, Tx{}, T_{}, H{}, M{}, Tm{}, Dm{}, G{}, out{}, mutexF{}, J{}, EPS{ 0.0 }, fit{ Fitting::SPECTRAL },
+      published{ 0 }, waiters{},
+      mutant{ false }
+    {
+      share( D );
+    }
+                                                                                                                              /*
+    Moved-from object has no queue, the next `update` allocates new one. Move wakes nobody: coroutines
+    awaiting approximation of the moved-from object stay linked to it (awaiter refers to the object it was
+    created by) until it publishes again or is destroyed:
+                                                                                                                              */
+    Dynamic( Dynamic&& D ) noexcept:
       CAPACITY{ D.CAPACITY             },
       F       { D.F                    },
-      S       { new Sample[ CAPACITY ] },
+      mutexQ  {                        },
+      S       { std::move( D.S )       },
+      copied  { D.copied               },
       pos     { D.pos                  },
       len     { D.len                  },
+      WINDOW  { D.WINDOW               },
+      BUCKET  { D.BUCKET               },
+      K       { std::move( D.K )       },
+      REORDER { D.REORDER              },
+      overdue { D.overdue              },
+      mutexP  {                        },
       P       { D.P                    },
+      Q       { D.Q                    },
+      TRIM    { D.TRIM                 },
       To      { D.To                   },
       Tt      { D.Tt                   },
       Tx      { D.Tx                   },
       T_      { D.T_                   },
-      mutexP{}, mutexQ{}, mutant{}
+      H       { std::move( D.H )       },
+      M       { std::move( D.M )       },
+      Tm      { D.Tm                   },
+      Dm      { D.Dm                   },
+      G       { std::move( D.G )       },
+      out     { std::move( D.out )     },
+      mutexF  {                        },
+      J       { std::move( D.J )       },
+      EPS     { D.EPS                  },
+      fit     { D.fit                  },
+      published{ D.published.load()    },
+      waiters {                        },
+      mutant  { D.mutant.load()        }
     {
-      for( auto i: RANGE{ len } ) S[i] = D.S[i];
-      mutant.store( D.mutant.load() );
+      D.abandon();
     }
 
     Dynamic& operator= ( const Dynamic& D ){                                                                   // [m] 2021.12.08
@@ -88,29 +452,69 @@ namespace CoreAGI {
       Assignment can be done only when both sides use the same functional basis:
                                                                                                                               */
       if( &F != &D.F ) throw std::invalid_argument( "Functional basises must be identical" );
-      delete[] S;
+      if( this != &D ) share( D );
+      return *this;
+    }
+
+    Dynamic& operator= ( Dynamic&& D ) noexcept {
+      assert( &F == &D.F ); // :functional basises must be identical
+      if( this == &D ) return *this;
       CAPACITY = D.CAPACITY;
-      S        = new Sample[ CAPACITY ];
+      S        = std::move( D.S );
+      copied   = D.copied;
       pos      = D.pos;
       len      = D.len;
+      WINDOW   = D.WINDOW;
+      BUCKET   = D.BUCKET;
+      K        = std::move( D.K );
+      REORDER  = D.REORDER;
+      overdue  = D.overdue;
       P        = D.P;
+      Q        = D.Q;
+      TRIM     = D.TRIM;
       To       = D.To;
       Tt       = D.Tt;
       Tx       = D.Tx;
       T_       = D.T_;
+      H        = std::move( D.H );
+      M        = std::move( D.M );
+      Tm       = D.Tm;
+      Dm       = D.Dm;
+      G        = std::move( D.G );
+      out      = std::move( D.out );
+      J        = std::move( D.J );
+      EPS      = D.EPS;
+      fit      = D.fit;
       mutant.store( D.mutant.load() );
-      for( auto i: RANGE{ len } ) S[i] = D.S[i];
+      D.abandon();
       return *this;
     }
-
-   ~Dynamic(){
-      delete[] S;
+                                                                                                                              /*
+    Coroutines awaiting the next approximation are resumed with no approximation (see `next_fit`); threads
+    blocked in `wait` must be woken (or joined) by the owner before destruction:
+                                                                                                                              */
+   ~Dynamic(){ waiters.close(); }
+                                                                                                                              /*
+    True if the queue of samples may be shared with a copy, i.e. copied and not written since:
+                                                                                                                              */
+    bool shared() const {
+      const std::lock_guard< std::mutex > lock( mutexQ );
+      return copied;
     }
 
-    constexpr bool defined() const { return P.defined(); }
+//  constexpr bool defined() const { return P.defined(); }                                               // [-] 2026.10.18
+    bool defined() const {
+      const std::lock_guard< std::mutex > lock( mutexP );
+      return P.defined();
+    }
 
     constexpr unsigned order() const { return N; }
 
+    unsigned capacity() const {
+      const std::lock_guard< std::mutex > lock( mutexQ );
+      return CAPACITY;
+    }
+
     unsigned length() const {
       const std::lock_guard< std::mutex > lock( mutexQ );
       const unsigned L{ len };
@@ -122,19 +526,299 @@ namespace CoreAGI {
       return std::make_tuple( P, To, Tt, Tx );
     }
 
+    std::tuple< Polynomial< N, Real >, Time > local() const {
+                                                                                                                              /*
+      Approximation as polynomial of the time `s = t - Tt` relative to the last sample, and `Tt`:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexP );
+      return std::make_tuple( P.compose( 2.0/T_, 2.0*( Tt - To )/T_ - 1.0 ), Tt );
+    }
+
+    Time crossing( const Real& level, const Time& from, const Time& upto ) const {
+                                                                                                                              /*
+      The earliest time in [ from, upto ] when approximation reaches `level`; NaN if there is no such time;
+      `from` if approximation is constant equal to `level`. Level touched without crossing (extremum equal
+      to `level`, root of even multiplicity) found only if approximation is exactly equal to `level` at the
+      extremum; use `extrema` to check such contact:
+                                                                                                                              */
+      Polynomial< N, Real > Q, C;
+      Time to, t_;
+      {
+        const std::lock_guard< std::mutex > lock( mutexP );
+        Q = P, to = To, t_ = T_;
+      }
+      C = level;
+      Q = Q - C;
+      if( not Q.defined() or from > upto ) return std::numeric_limits< Time >::quiet_NaN();
+      if( Q.zero() ) return from;
+      Real x[ N ];
+      const unsigned n{ Q.roots( Real( 2.0*( from - to )/t_ - 1.0 ), Real( 2.0*( upto - to )/t_ - 1.0 ), x ) };
+      return n > 0 ? to + 0.5*( x[0] + 1.0 )*t_ : std::numeric_limits< Time >::quiet_NaN();
+    }
+
+    std::tuple< Time, Real, Time, Real > extrema( const Time& from, const Time& upto ) const {
+                                                                                                                              /*
+      Minimum and maximum of approximation in [ from, upto ]: ( time of minimum, minimum, time of maximum, maximum ):
+                                                                                                                              */
+      Polynomial< N, Real > Q;
+      Time to, t_;
+      {
+        const std::lock_guard< std::mutex > lock( mutexP );
+        Q = P, to = To, t_ = T_;
+      }
+      auto[ xmin, pmin, xmax, pmax ] = Q.extrema( Real( 2.0*( from - to )/t_ - 1.0 ), Real( 2.0*( upto - to )/t_ - 1.0 ) );
+      return std::make_tuple( to + 0.5*( xmin + 1.0 )*t_, pmin, to + 0.5*( xmax + 1.0 )*t_, pmax );
+    }
+
+    bool within( const Real& lo, const Real& hi, const Time& from, const Time& upto ) const {
+                                                                                                                              /*
+      True if approximation stays in [ lo, hi ] over the time interval [ from, upto ]:
+                                                                                                                              */
+      const auto[ tmin, pmin, tmax, pmax ] = extrema( from, upto );
+      return lo <= pmin and pmax <= hi;
+    }
+
+    void warmStart( bool on ){
+                                                                                                                              /*
+      Keep eigen vectors of the previous fit and start the next one from them; efficient for sliding
+      window where successive matrices differ slightly:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexF );
+      if( on and not J ) J = std::make_unique< Eigen< N, Real > >();
+      if( not on ) J.reset();
+    }
+
+    void tolerance( const Real& eps ){
+                                                                                                                              /*
+      Relative convergence tolerance of the eigen solver (see `Eigen::tolerance`); 0 (default) keeps cheaper
+      absolute test:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexF );
+      EPS = eps;
+    }
+
+    void fitting( Fitting method ){
+      const std::lock_guard< std::mutex > lock( mutexF );
+      fit = method;
+    }
+
+    std::tuple< ChebyshevSeries< N, Real >, Time, Time, Time > series() const {
+      const std::lock_guard< std::mutex > lock( mutexP );
+      return std::make_tuple( Q, To, Tt, Tx );
+    }
+
+    void truncation( const Real& tolerance ){
+                                                                                                                              /*
+      Approximation drops tail Chebyshev coefficients that change it in [ To .. Tx ] not more than `tolerance`;
+      all views (value, grid, local form, crossing, extrema, `def`, publisher, checkpoint) use the truncated
+      approximation. Full series kept, so truncation can be changed later:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexP );
+      TRIM = tolerance;
+      if( not Q.defined() ) return;
+      Q.trim( TRIM );
+      P = Q.polynomial();
+      evaluate();
+      if( out ) out( P, To, Tt, Tx );
+    }
+
+    void publisher( Publisher f ){
+                                                                                                                              /*
+      Set receiver called by `process` (under the lock of the published state, so calls are serialized) with
+      each new approximation; current approximation passed immediately if defined:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexP );
+      out = std::move( f );
+      if( out and P.defined() ) out( P, To, Tt, Tx );
+    }
+                                                                                                                              /*
+    Number of approximations published so far (increases with each `process` that published result):
+                                                                                                                              */
+    std::uint64_t epoch() const { return published.load( std::memory_order_acquire ); }
+                                                                                                                              /*
+    Block the thread until epoch differs from `seen` (futex-based `std::atomic::wait`, no polling); returns
+    the new epoch:
+                                                                                                                              */
+    std::uint64_t wait( std::uint64_t seen ) const {
+      published.wait( seen, std::memory_order_acquire );
+      return epoch();
+    }
+                                                                                                                              /*
+    Awaiter of the approximation published after epoch `seen`; `co_await` yields `def()` of that approximation.
+    Coroutine is resumed by the thread that published it (at the end of its `FitBatch` if any). Object
+    destroyed before publication resumes the coroutine with empty result, and it must not use the object:
+                                                                                                                              */
+    class NextFit: Waiters::Node {
+      const Dynamic&      D;
+      const std::uint64_t seen;
+    public:
+      NextFit( const Dynamic& D, std::uint64_t seen ): Waiters::Node{}, D{ D }, seen{ seen }{}
+      bool await_ready() const { return D.epoch() != seen; }
+      bool await_suspend( std::coroutine_handle<> h ){
+        handle = h;
+        return D.waiters.push( *this, [this]{ return D.epoch() != seen; } );
+      }
+      std::optional< std::tuple< Polynomial< N, Real >, Time, Time, Time > > await_resume() const {
+        if( closed ) return std::nullopt;
+        return D.def();
+      }
+    };
+
+    NextFit next_fit() const { return NextFit( *this, epoch() ); }
+
+    NextFit next_fit( std::uint64_t seen ) const { return NextFit( *this, seen ); }
+
+    void lookahead( std::span< const Time > offsets ){
+                                                                                                                              /*
+      Set lookahead grid: offsets relative to the time of the last sample `Tt` at which `process`
+      evaluates approximation; values available via `grid( values )`:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexP );
+      H.assign( offsets.begin(), offsets.end() );
+      M.assign( H.size()*N, 0.0 );
+      G.assign( H.size(), std::numeric_limits< Real >::quiet_NaN() );
+      Tm = std::numeric_limits< Time >::quiet_NaN(); // :force calculation of M
+      if( P.defined() ) evaluate();
+    }
+
+    Time grid( /*out*/ Real* values ) const {
+                                                                                                                              /*
+      Copy values on the lookahead grid into `values[]` (size of the grid); returns time `Tt` the
+      grid offsets relative to:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexP );
+      for( auto j: RANGE{ unsigned( G.size() ) } ) values[j] = G[j];
+      return Tt;
+    }
+
+    unsigned samples( Sample* R ) const {
+                                                                                                                              /*
+      Copy samples into `R` (at least CAPACITY elements) in chronological order; returns number of samples:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexQ );
+      const unsigned o{ ( pos + CAPACITY - len ) % CAPACITY }; // :position of the oldest sample
+      for( auto i: RANGE{ len } ) R[i] = S[ ( o + i ) % CAPACITY ];
+      return len;
+    }
+
+    std::tuple< unsigned, Polynomial< N, Real >, Time, Time, Time, bool > state( Sample* R ) const {
+                                                                                                                              /*
+      Samples (as `samples`) and approximation (as `def`) taken at once, between calls of `process`; the flag
+      is true if approximation fits exactly these samples:
+                                                                                                                              */
+      const std::scoped_lock lock( mutexF, mutexQ, mutexP );
+      const unsigned o{ ( pos + CAPACITY - len ) % CAPACITY }; // :position of the oldest sample
+      for( auto i: RANGE{ len } ) R[i] = S[ ( o + i ) % CAPACITY ];
+      return std::make_tuple( len, P, To, Tt, Tx, not mutant.load() );
+    }
+
+    void restore( const Sample* R, unsigned n, const Polynomial< N, Real >& p, const Time& to, const Time& tt, const Time& tx, bool fitted = true ){
+                                                                                                                              /*
+      Restore state saved by `state` (e.g. from checkpoint): the newest CAPACITY of `n` samples of `R` in
+      chronological order and approximation; when approximation undefined or not `fitted` to these samples,
+      `process` refits:
+                                                                                                                              */
+      const unsigned m{ n < CAPACITY ? n : CAPACITY };
+      std::unique_lock< std::mutex > fitter( mutexF ); // :no `process` in progress; released before `notify`
+      {
+        const std::lock_guard< std::mutex > lock( mutexQ );
+        if( copied or not S ){ S = std::make_shared< Sample[] >( CAPACITY ); copied = false; } // :queue shared with copy is kept intact
+        for( auto i: RANGE{ m } ) S[i] = R[ n - m + i ];
+        len = m;
+        pos = m % CAPACITY;
+        K.clear(); // :samples waiting for reordering are discarded
+        mutant.store( m > 0 and not ( fitted and p.defined() ) );
+      }
+      {
+        const std::lock_guard< std::mutex > lock( mutexP );
+        Q  = ChebyshevSeries< N, Real >( p );
+        P  = Q.trim( TRIM ) < N ? Q.polynomial() : p;
+        To = to;
+        Tt = tt;
+        Tx = tx;
+        T_ = tx > to ? tx - to : 1.0;
+        evaluate();
+        if( out and P.defined() ) out( P, To, Tt, Tx );
+      }
+      fitter.unlock();
+      notify();
+    }
+
     void clear(){
       const std::lock_guard< std::mutex > lock( mutexQ );
       len = 0;
       pos = 0;
+      K.clear();
       mutant.store( true );
     }
 
-    unsigned update( const Time& t, const Real& v ){
+    void decimation( const Time& window, const Time& bucket ){
+                                                                                                                              /*
+      Rate-adaptive ingest: samples aggregated into buckets of width `bucket` (count-weighted mean of time and
+      value), and only samples within `window` before the newest one are approximated. Capacity not less
+      than `window/bucket` keeps time range covered by approximation fixed for any input rate:
+                                                                                                                              */
+      const std::lock_guard< std::mutex > lock( mutexQ );
+      WINDOW = window;
+      BUCKET = bucket;
+    }
+
+    void reorder( unsigned k ){
+                                                                                                                              /*
+      Out-of-order ingest: up to `k` the newest samples wait in the reorder buffer and enter the queue in
+      chronological order, so `process` still reads time-ordered queue; insertion costs O(log k). Samples
+      of the same time are merged, sample older than the newest one in the queue is dropped (see `late`).
+      Approximation lags `k` samples behind the input; `flush` commits waiting samples. Zero `k` (default)
+      restores in-order ingest:
+                                                                                                                              */
+      unsigned L{ 0 };
+      Sample   last;
+      bool     modified{ false };
+      {
+        const std::lock_guard< std::mutex > lock( mutexQ );
+        own();
+        REORDER  = k;
+        K.reserve( k + 1 );
+        modified = commit( k );
+        L        = len;
+        if( L > 0 ) last = S[ pos > 0 ? pos-1 : CAPACITY-1 ];
+      }
+      if( modified ) changed( L, last );
+    }
+
+    unsigned flush(){
+                                                                                                                              /*
+      Commit all samples waiting in the reorder buffer; returns number of samples in the queue:
+                                                                                                                              */
+      unsigned L{ 0 };
+      Sample   last;
+      bool     modified{ false };
+      {
+        const std::lock_guard< std::mutex > lock( mutexQ );
+        if( not K.empty() ) own();
+        modified = commit( 0 );
+        L        = len;
+        if( L > 0 ) last = S[ pos > 0 ? pos-1 : CAPACITY-1 ];
+      }
+      if( modified ) changed( L, last );
+      return L;
+    }
+                                                                                                                              /*
+    Number of samples dropped because they came later than reorder window allows:
+                                                                                                                              */
+    unsigned long late() const {
+      const std::lock_guard< std::mutex > lock( mutexQ );
+      return overdue;
+    }
+
+    unsigned update( const Time& t, const Real& v, const Real& w = 1.0 ){
       unsigned L{ 0 };
+      Sample   last;   // :the newest sample
       {                                                                                                                       /*
         Lock queue:
                                                                                                                               */
         const std::lock_guard< std::mutex > lock( mutexQ );
+        own(); // :copy-on-write
                                                                                                                               /*
         Update queue:
                                                                                                                               */
@@ -145,34 +829,24 @@ namespace CoreAGI {
 //          for( auto i: RANGE{ 1u, CAPACITY } ) S[ i-1 ] = S[ i ];  // :shift
 //          S[ CAPACITY-1 ] = Sample{ t, v };
 //        }
-        if( len < CAPACITY ){
-                                                                                                                              /*
-          `len` and `pos` values are the same:
-                                                                                                                              */
-          S[ pos++ ] = Sample{ t, v };
-          len++;
+        if( REORDER == 0 ){
+          append( Sample{ t, v, w } );
         } else {
-                                                                                                                              /*
-          `len` not changed, `pos` changed cyclically:
-                                                                                                                              */
-          assert( len == CAPACITY );
-          if( ++pos >= CAPACITY ) pos = 0;
-          S[ pos ] = Sample{ t, v };
-        }
-        L = len;
-      }
-      if( len == 1 ){
-                                                                                                                              /*
-        Assign approximation polynomial that actually represents constant:
-                                                                                                                              */
-        {
-          const std::lock_guard< std::mutex > lock( mutexP );
-          P = v;
+          if( len > 0 and t < S[ pos > 0 ? pos-1 : CAPACITY-1 ].t ){ overdue++; return len; } // :too late
+          K.emplace_back( t, v, w );
+          std::push_heap( K.begin(), K.end(), later );
+          if( not commit( REORDER ) ) return len; // :sample waits in the reorder buffer
         }
-        mutant.store( false );
-      } else {
-        mutant.store( true );
+        L    = len;
+        last = S[ pos > 0 ? pos-1 : CAPACITY-1 ];
       }
+//    if( L == 1 ){
+//      ...
+//      mutant.store( false );                                                                            // [-] 2026.10.18
+//    } else {
+//      mutant.store( true );
+//    }
+      changed( L, last );
       return L;
     }//update
 
@@ -183,7 +857,14 @@ namespace CoreAGI {
       Time      // :elapsed time, microsec
     > process(){
 
-      if( not mutant.load() ) return std::make_tuple( 0, 0, 0.0, 0.0 ); // :no changes, nothing to do
+      std::unique_lock< std::mutex > fitter( mutexF ); // :released before `notify`
+                                                                                                                              /*
+      Flag reset before the samples are copied: update that comes after the copy sets it again, so the
+      sample is fitted by the next call instead of being lost when the result is published:
+                                                                                                                              */
+//    if( not mutant.load() ) return std::make_tuple( 0, 0, 0.0, 0.0 );                                    // [-] 2026.10.18
+      if( not mutant.exchange( false ) ) return std::make_tuple( 0, 0, 0.0, 0.0 ); // :no changes, nothing to do
+      TRACE_ZONE( "Dynamic::process" );
                                                                                                                               /*
       (Re)Calculate approximation:
                                                                                                                               */
@@ -192,24 +873,39 @@ namespace CoreAGI {
 
       Time     T[ CAPACITY ];
       Real     Y[ CAPACITY ];
+      Real     W[ CAPACITY ];
       unsigned L;
       {
                                                                                                                               /*
-        Lock samples S and copy data into T and V:
+        Lock samples S and copy data into T and V in chronological order:
                                                                                                                               */
+        TRACE_ZONE( "Dynamic::snapshot" );
         const std::lock_guard< std::mutex > lock( mutexQ );
-        assert( len > 0 );
-        for( auto i: RANGE{ len } ) T[i] = S[i].t, Y[i] = S[i].v;
+        const unsigned o{ ( pos + CAPACITY - len ) % CAPACITY }; // :the oldest sample
+        const Time     t0{ WINDOW > 0.0 ? S[ ( o + len - 1 ) % CAPACITY ].t - WINDOW : -std::numeric_limits< Time >::infinity() };
+        L = 0;
+        for( auto i: RANGE{ len } ){
+          const Sample& Si{ S[ ( o + i ) % CAPACITY ] };
+          if( Si.t < t0 ) continue; // :out of time window
+          T[L] = Si.t, Y[L] = Si.v, W[L] = Si.w;
+          L++;
+        }
+      }
+      if( L < 2 ){
                                                                                                                               /*
-        Remember cureent length, original one can be changed any time:
+        Queue cleared or single sample within the time window:
                                                                                                                               */
-        L = len;
+        const Sample s{ L > 0 ? Sample{ T[0], Y[0], W[0] } : Sample{} };
+        constant( L > 0 ? &s : nullptr );
+        fitter.unlock();
+        notify();
+        return std::make_tuple( 0, L, 1.0, 0.0 );
       }
                                                                                                                               /*
       Local utility values:
                                                                                                                               */
       const Time& to{ T[   0   ]              };
-      const Time& tt{ T[ len-1 ]              };
+      const Time& tt{ T[ L-1 ]                };
       const Time  tx{ tt + FACTOR*( tt - to ) };
       const Time  t_{ tx - to                 };
                                                                                                                               /*
@@ -219,11 +915,12 @@ namespace CoreAGI {
                                                                                                                               /*
       Approximation:
                                                                                                                               */
-      Polynomial< N > p;  // :desired polynomial
-      Time            dt; // :elapsed time
-      unsigned        nr; // :number of rotation in the Jacoby
-      unsigned        nc; // :actual number of used eigen vectors
-      Real            cn; // :condition number
+      Polynomial< N, Real > p;  // :desired polynomial
+      ChebyshevSeries< N, Real > q; // :desired polynomial in Chebyshev form
+      Time                  dt; // :elapsed time
+      unsigned              nr; // :number of rotation in the Jacoby
+      unsigned              nc; // :actual number of used eigen vectors
+      Real                  cn; // :condition number
 
       {
 
@@ -231,44 +928,80 @@ namespace CoreAGI {
                                                                                                                               /*
         Convert time to dimensionless X:[ -1 .. 1 ]:
                                                                                                                               */
-        Real X[ 32 ];
+        Real X[ CAPACITY ];
         for( auto k: RANGE{ L } ) X[k] = U( T[k] );
+
+        CoreAGI::CycleTimer timer;
+        if( fit == Fitting::FORSYTHE ){
+                                                                                                                              /*
+          Orthogonal polynomials: number of used polynomials reported as number of eigen values, Gram matrix
+          is identity:
+                                                                                                                              */
+          {
+            TRACE_ZONE( "forsythe" );
+            nc = forsythe< N, Real >( p, X, Y, W, L );
+            q  = ChebyshevSeries< N, Real >( p );
+          }
+          nr = 0;
+          cn = 1.0;
+          dt = timer.elapsed( Timer::MICROSEC );
+        } else {
+                                                                                                                              /*
+          Compose problem `AC = B`:
+                                                                                                                              */
+          CoreAGI::Eigen< N, Real >  local;
+          CoreAGI::Eigen< N, Real >& E{ J ? *J : local };
+          E.clear();
+          E.tolerance( EPS );
+          Real B[N]; memset( B, 0, N*sizeof( Real ) );
+          {
+            TRACE_ZONE( "Dynamic::gram" );
+            for( auto k: RANGE{ L } ){
+              const Real& Xk{ X[k] };
+              const Real& Wk{ W[k] };
+              for( auto i: RANGE{ N } ) for( auto j: RANGE{ i+1 } ) E.add( i, j, Wk*F[i]( Xk )*F[j]( Xk ) );
+              for( auto i: RANGE{ N } ) B[i] += Wk*F[i]( Xk )*Y[k];
+            }//for k
+          }
                                                                                                                               /*
-        Compose problem `AC = B`:
+          Solve problem:
                                                                                                                               */
-        CoreAGI::Timer timer;
-        CoreAGI::Eigen< N, Real > E;
-        Real B[N]; memset( B, 0, N*sizeof( Real ) );
-        for( auto k: RANGE{ L } ){
-          const Real& Xk{ X[k] };
-          for( auto i: RANGE{ N } ) for( auto j: RANGE{ i+1 } ) E.add( i, j, F[i]( Xk )*F[j]( Xk ) );
-          for( auto i: RANGE{ N } ) B[i] += F[i]( Xk )*Y[k];
-        }//for k
+          Real C[ N ]; memset( C, 0, N*sizeof( Real ) );
+          nc = E.linearSystem( C, B, COND, bool( J ) );
+          nr = E.rotationNumber();
+          dt = timer.elapsed( Timer::MICROSEC );
+          cn = E.eigenValue( 0 )/E.eigenValue( nc-1 );
                                                                                                                               /*
-        Solve problem:
+          Compose desired polynomial as linear combination of elements of polynomial basis:
                                                                                                                               */
-        Real C[ N ]; memset( C, 0, N*sizeof( Real ) );
-        nc = E.linearSystem( C, B, COND );
-        nr = E.rotationNumber();
-        dt = timer.elapsed( Timer::MICROSEC );
-        cn = E.eigenValue( 0 )/E.eigenValue( nc-1 );
+          p = F( C );
                                                                                                                               /*
-        Compose desired polynomial as linear combination of elements of polynomial basis:
+          Chebyshev form as the same linear combination of Chebyshev forms of basis elements (precomputed by
+          the basis):
                                                                                                                               */
-        p = F( C );
+          Real c[ N ];
+          F.toChebyshev( C, c );
+          q = ChebyshevSeries< N, Real >( c );
+        }
       }
                                                                                                                               /*
       Lock and update C[*], To, Tt, Tx:
                                                                                                                               */
       {
+        TRACE_ZONE( "Dynamic::publish" );
         const std::lock_guard< std::mutex > lock( mutexP );
-        P  = p;
+        Q  = q;
+        P  = Q.trim( TRIM ) < N ? Q.polynomial() : p; // :published approximation is the one evaluated
         To = to;
         Tt = tt;
         Tx = tx;
         T_ = t_;
-        mutant.store( false );
+        evaluate();
+        if( out ) out( P, To, Tt, Tx );
+//      mutant.store( false );                                                                            // [-] 2026.10.18
       }
+      fitter.unlock();
+      notify();
       return std::make_tuple( nr, nc, cn, dt );
     }//process
 
@@ -281,7 +1014,7 @@ namespace CoreAGI {
        -1 when t < To
                                                                                                                               */
       const std::lock_guard< std::mutex > lock( mutexP );
-      auto value = P( 2.0*( t  - To )/T_ - 1.0 ); // :mapping t:[ To, Tx ] => x:[ -1, 1 ]
+      auto value = Q( 2.0*( t  - To )/T_ - 1.0 ); // :mapping t:[ To, Tx ] => x:[ -1, 1 ]
       if( note ){
         if( std::isnan( value ) ) *note = RangePoint::UNDEFINED;
         else *note = t > Tx ? RangePoint::FORWARD : ( t < To ? RangePoint::BACKWARD : RangePoint::INSIDE );
@@ -12,6 +12,12 @@ ________________________________________________________________________________
 
   2021.11.11 Use `memset` to clear arrays
 
+  2026.10.18 Relative convergence tolerance; early exit; warm start from eigen vectors of the previous run
+
+  2026.10.18 Trace zones
+
+  2026.10.18 Parallel ordering of rotations (Brent-Luk), used by default for N > 8
+
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef EIGEN_H_INCLUDED
@@ -20,10 +26,19 @@ ________________________________________________________________________________
 #include <cmath>
 #include <cstring>             // :memset                                                                         [+] 2021.11.11
 #include <type_traits>
+#include <utility>             // :std::swap
 
 #include "heapsort.h"
+#include "trace.h"
 
 namespace CoreAGI {
+                                                                                                                              /*
+  Order of Jacobi rotations:
+    AUTO     - CYCLIC for N <= 8, PARALLEL otherwise
+    CYCLIC   - classical cyclic sweep by pairs (p,q), each rotation applied immediately
+    PARALLEL - round-robin (Brent-Luk) ordering: N/2 disjoint pairs per step rotated together
+                                                                                                                              */
+  enum class Ordering: unsigned { AUTO = 0, CYCLIC, PARALLEL };
 
   template< unsigned N, typename Real = long double > class Eigen {
 
@@ -32,6 +47,10 @@ namespace CoreAGI {
     static_assert( std::numeric_limits< Real >::has_infinity );
 
     unsigned Nrot;
+    Real     EPS;        // :absolute convergence tolerance: sum of off-diagonal elements
+    Real     REL;        // :relative convergence tolerance of each off-diagonal element; 0 means not used
+    bool     warm;       // :eigen vectors of the previous successful run available
+    Ordering mode;       // :order of rotations
     Real     A  [N][N];
     Real     V  [N][N];
     Real     D  [N];
@@ -41,7 +60,7 @@ namespace CoreAGI {
 
   public:
 
-    Eigen(): Nrot{ 0 }, A{}, V{}, D{}, B{},Z{}, ord{}{
+    Eigen(): Nrot{ 0 }, EPS{ 1.0E-10 }, REL{ 0.0 }, warm{ false }, mode{ Ordering::AUTO }, A{}, V{}, D{}, B{},Z{}, ord{}{
       for( unsigned i = 0; i < N; i++ ){
         ord[i] = i;
         // for( auto& Aij: A[i] ) Aij = 0;                                                                     // [-] 2021.11.11
@@ -67,6 +86,14 @@ namespace CoreAGI {
     Real matrix( unsigned i, unsigned j ) const { return ( i < N and j < N ) ? A[i][j] : 0.0; }
 
     unsigned rotationNumber() const { return Nrot; }
+                                                                                                                              /*
+    Convergence: by default sum of absolute values of off-diagonal elements less than EPS. Positive `eps`
+    replaces it by relative test: each off-diagonal element A[p][q] not greater than `eps*sqrt( |A[p][p]*A[q][q]| )`,
+    that keeps relative accuracy of the small eigen values at the cost of more rotations; 0 restores default:
+                                                                                                                              */
+    void tolerance( Real eps ){ REL = eps > 0.0 ? eps : 0.0; }
+
+    void ordering( Ordering order ){ mode = order; }
 
     void sort(){
       heapSort< unsigned >( ord, N,
@@ -81,11 +108,11 @@ namespace CoreAGI {
       );
     }
 
-    unsigned linearSystem( /*out*/ Real* x, const Real* b, Real condition ){
+    unsigned linearSystem( /*out*/ Real* x, const Real* b, Real condition, bool warmStart = false ){
                                                                                                                               /*
       Solution of linear system Ax=b using eigen vectors:
                                                                                                                               */
-      if( not run() ) return 0;
+      if( not run( warmStart ) ) return 0;
       sort();
       Real c[N];
       const unsigned nc = spectral( c, b, condition );
@@ -105,6 +132,7 @@ namespace CoreAGI {
                                                                                                                       /*
       Calculate spectral coefficients c[] for particular right vector b and conditional number:
                                                                                                                       */
+      TRACE_ZONE( "Eigen::spectral" );
       Real limit = eigenValue( 0 ) / condition; // :eigen balues sorted in `linearSystem` befor call this
       Real ek[N];
       unsigned n{ 0 };
@@ -120,19 +148,41 @@ namespace CoreAGI {
       return n;
     }
 
-    bool run(){
-
+    bool run( bool warmStart = false ){
+                                                                                                                              /*
+      Jacobi eigen value algorithm. Warm start (matrix A should be completely redefined after previous run):
+      matrix rotated into the basis of eigen vectors of the previous run, so for slightly changed matrix
+      only nearly diagonal remainder processed:
+                                                                                                                              */
+      TRACE_ZONE( "Eigen::run" );
       using namespace std;
 
-      constexpr Real EPS{ 1.0E-10 }; // :NB can be modified
+      // constexpr Real EPS{ 1.0E-10 }; // :NB can be modified                                                 // [-] 2026.10.18
 
       Real c, g, h, s, Sm, t, tau, theta, tresh;
-      for( unsigned p = 0; p < N; p++ ){
-        // for( unsigned q = 0; q < N; q++ ) V[p][q] = 0;                                                      // [-] 2021.11.11
-        memset( V[p], 0, N*sizeof( Real ) );                                                                   // [+] 2021.11.11
-        V[p][p] = 1.0;
-        ord[p] = p;
+      if( warmStart and warm ){
+        Real W[N][N]; // :A*V
+        for( unsigned p = 0; p < N; p++ ) for( unsigned q = 0; q < N; q++ ){
+          Real Wpq{ 0.0 };
+          for( unsigned k = 0; k < N; k++ ) Wpq += A[p][k]*V[k][q];
+          W[p][q] = Wpq;
+        }
+        for( unsigned p = 0; p < N; p++ ) for( unsigned q = p; q < N; q++ ){
+          Real Apq{ 0.0 };
+          for( unsigned k = 0; k < N; k++ ) Apq += V[k][p]*W[k][q];
+          A[p][q] = A[q][p] = Apq;
+        }
+        for( unsigned p = 0; p < N; p++ ) ord[p] = p;
+      } else {
+        for( unsigned p = 0; p < N; p++ ){
+          // for( unsigned q = 0; q < N; q++ ) V[p][q] = 0;                                                    // [-] 2021.11.11
+          memset( V[p], 0, N*sizeof( Real ) );                                                                 // [+] 2021.11.11
+          V[p][p] = 1.0;
+          ord[p] = p;
+        }
       }
+      warm = false;
+      if( mode == Ordering::PARALLEL or ( mode == Ordering::AUTO and N > 8 ) ) return parallel( 50 );
       for( unsigned p = 0; p < N; p++ ){
         B[p] = A[p][p];
         D[p] = B[p];
@@ -141,9 +191,15 @@ namespace CoreAGI {
       Nrot = 0;
       for( unsigned i = 1; i <= 50; i++ ){ //NB increase 50 to 100?
         Sm = 0.0;
-        for( unsigned p = 0; p < N - 1; p++ ) for( unsigned q = p + 1; q < N; q++ ) Sm += std::abs( A[p][q] );
-        if( Sm < EPS ) return true;
+        bool small{ REL > 0.0 };
+        for( unsigned p = 0; p < N - 1; p++ ) for( unsigned q = p + 1; q < N; q++ ){
+          const Real Apq{ std::abs( A[p][q] ) };
+          Sm += Apq;
+          if( small and Apq*Apq > REL*REL*std::abs( D[p]*D[q] ) ) small = false;
+        }
+        if( REL > 0.0 ? small : Sm < EPS ) return warm = true;
         tresh = ( i < 4 ) ? 0.2 * Sm / ( N * N ) : 0.0;
+        const unsigned nrot{ Nrot };
         for( unsigned p = 0; p < N - 1; p++ ){
           for( unsigned q = p + 1; q < N; q++ ){
             g = 100 * std::abs( A[p][q] );
@@ -206,9 +262,120 @@ namespace CoreAGI {
           D[p]  = B[p];
           Z[p]  = 0;
         }
+        if( Nrot == nrot and i > 4 ) return warm = true; // :all off-diagonal elements negligible
       }
       return false;
     }
+
+  private:
+
+    static void rotate( Real (&X)[N][N], const unsigned* P, const unsigned* Q, const Real* C, const Real* S, unsigned n ){
+                                                                                                                              /*
+      Rotation of pairs of rows: X[p] = c*X[p] - s*X[q], X[q] = s*X[p] + c*X[q]; rows are contiguous, so the
+      inner loop is vectorized:
+                                                                                                                              */
+      for( unsigned k = 0; k < n; k++ ){
+        Real* __restrict__ Xp{ X[ P[k] ] };
+        Real* __restrict__ Xq{ X[ Q[k] ] };
+        const Real         c { C[k] };
+        const Real         s { S[k] };
+        for( unsigned j = 0; j < N; j++ ){
+          const Real g{ Xp[j] };
+          const Real h{ Xq[j] };
+          Xp[j] = c*g - s*h;
+          Xq[j] = s*g + c*h;
+        }
+      }
+    }
+
+    static void rotateColumns( Real (&X)[N][N], const unsigned* P, const unsigned* Q, const Real* C, const Real* S, unsigned n ){
+                                                                                                                              /*
+      Rotation of pairs of columns, row by row (each row touched once for all pairs of the step):
+                                                                                                                              */
+      for( unsigned j = 0; j < N; j++ ){
+        Real* const Xj{ X[j] };
+        for( unsigned k = 0; k < n; k++ ){
+          const Real g{ Xj[ P[k] ] };
+          const Real h{ Xj[ Q[k] ] };
+          Xj[ P[k] ] = C[k]*g - S[k]*h;
+          Xj[ Q[k] ] = S[k]*g + C[k]*h;
+        }
+      }
+    }
+
+    bool parallel( unsigned sweeps ){
+                                                                                                                              /*
+      Jacobi algorithm with parallel ordering: round-robin tournament splits indices into N/2 disjoint pairs
+      at each step, so rotations of the step are independent and applied to the whole (symmetric, both
+      triangles kept) matrix at once: A <- J'A J as rotations of pairs of rows, then of pairs of columns.
+      Eigen vectors accumulated as rows of U = V'. Sweep consists of N-1 steps (N for odd N, with dummy
+      index) and meets each pair once. Convergence criterion is the same as for the cyclic ordering:
+                                                                                                                              */
+      using namespace std;
+      constexpr unsigned M{ N + N % 2 }; // :number of indices including dummy one for odd N
+      unsigned I[ M ];                   // :tournament table: pairs ( I[k], I[M-1-k] )
+      for( unsigned k = 0; k < M; k++ ) I[k] = k;
+      Real U[N][N];
+      for( unsigned i = 0; i < N; i++ ) for( unsigned j = 0; j < N; j++ ) U[i][j] = V[j][i];
+      Nrot = 0;
+      bool converged{ false };
+      for( unsigned i = 1; i <= sweeps and not converged; i++ ){
+        bool small{ REL > 0.0 };
+        Real Sm{ 0.0 };
+        for( unsigned p = 0; p < N - 1; p++ ) for( unsigned q = p + 1; q < N; q++ ){
+          const Real Apq{ std::abs( A[p][q] ) };
+          Sm += Apq;
+          if( small and Apq*Apq > REL*REL*std::abs( A[p][p]*A[q][q] ) ) small = false;
+        }
+        converged = REL > 0.0 ? small : Sm < EPS;
+        if( converged ) break;
+        const Real tresh{ ( i < 4 ) ? 0.2 * Sm / ( N * N ) : 0.0 }; // :large elements first, as in cyclic ordering
+        const unsigned nrot{ Nrot };
+        for( unsigned step = 0; step + 1 < M; step++ ){
+          unsigned P[ M/2 ], Q[ M/2 ], n{ 0 };
+          Real     C[ M/2 ], S[ M/2 ];
+          for( unsigned k = 0; k < M/2; k++ ){
+            unsigned p{ I[k] }, q{ I[ M-1-k ] };
+            if( p >= N or q >= N ) continue; // :pair with dummy index
+            if( p > q ) std::swap( p, q );
+            const Real Apq{ A[p][q] };
+            const Real g  { 100*std::abs( Apq ) };
+            if( i > 4 and std::abs( A[p][p] ) + g == std::abs( A[p][p] ) and std::abs( A[q][q] ) + g == std::abs( A[q][q] ) ){
+              A[p][q] = A[q][p] = 0.0; // :negligible, as in cyclic ordering
+              continue;
+            }
+            if( std::abs( Apq ) <= tresh ) continue;
+            if( REL > 0.0 and std::abs( Apq )*100 <= REL*sqrt( std::abs( A[p][p]*A[q][q] ) ) ) continue; // :already negligible
+            const Real theta{ 0.5*( A[q][q] - A[p][p] )/Apq };
+            Real t{ 1.0/( std::abs( theta ) + sqrt( 1.0 + theta*theta ) ) };
+            if( theta < 0 ) t = -t;
+            C[n] = 1.0/sqrt( 1.0 + t*t );
+            S[n] = t*C[n];
+            P[n] = p;
+            Q[n] = q;
+            n++;
+          }
+          if( n > 0 ){
+            rotate       ( A, P, Q, C, S, n );
+            rotateColumns( A, P, Q, C, S, n );
+            rotate( U, P, Q, C, S, n );
+            for( unsigned k = 0; k < n; k++ ) A[ P[k] ][ Q[k] ] = A[ Q[k] ][ P[k] ] = 0.0;
+            Nrot += n;
+          }
+          const unsigned last{ I[ M-1 ] }; // :round-robin: I[0] fixed, others shifted cyclically
+          for( unsigned k = M-1; k > 1; k-- ) I[k] = I[ k-1 ];
+          I[1] = last;
+        }
+        if( Nrot == nrot ) converged = true; // :all off-diagonal elements negligible
+      }
+      for( unsigned i = 0; i < N; i++ ) for( unsigned j = 0; j < N; j++ ) V[i][j] = U[j][i];
+      for( unsigned p = 0; p < N; p++ ){
+        B[p] = D[p] = A[p][p];
+        Z[p] = 0;
+        ord[p] = p;
+      }
+      return warm = converged;
+    }
 
   }; //class Eigen
 
@@ -0,0 +1,99 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef FORSYTHE_H_INCLUDED
+#define FORSYTHE_H_INCLUDED
+
+#include <cmath>
+#include <limits>
+
+#include "polynomial.h"
+
+namespace CoreAGI {
+
+  template< unsigned N, typename Real = double > unsigned forsythe(
+    /*out*/ Polynomial< N, Real >& P, // :least squares approximation
+    const Real*                    X, // :arguments of samples
+    const Real*                    Y, // :values of samples
+    const Real*                    W, // :weights of samples; `nullptr` means unit weights
+    unsigned                       L  // :number of samples
+  ){
+                                                                                                                              /*
+    Weighted least squares approximation by polynomials orthogonal over the samples (Forsythe):
+
+      p[-1] = 0,  p[0] = 1,  p[j+1]( x ) = ( x - a[j] )*p[j]( x ) - b[j]*p[j-1]( x )
+
+      a[j] = < x*p[j], p[j] >/< p[j], p[j] >,  b[j] = < p[j], p[j] >/< p[j-1], p[j-1] >
+
+    Coefficients c[j] = < y, p[j] >/< p[j], p[j] > need no matrix solution; result converted into monomial
+    form accumulating monomial coefficients of p[j] by the same recurrence. Returns number of used orthogonal
+    polynomials, that is less than N when samples do not define polynomial of order N:
+                                                                                                                              */
+    constexpr Real EPS{ std::numeric_limits< Real >::epsilon() };
+
+    Real u[ L ]; // :p[j-1] in sample points
+    Real v[ L ]; // :p[j]   in sample points
+    Real m[ N ]; // :monomial coefficients of p[j-1], lowest degree first
+    Real n[ N ]; // :monomial coefficients of p[j],   lowest degree first
+    Real c[ N ]; // :monomial coefficients of the result, lowest degree first
+
+    for( unsigned k = 0; k < L; k++ ) u[k] = 0.0, v[k] = 1.0;
+    for( unsigned i = 0; i < N; i++ ) m[i] = n[i] = c[i] = 0.0;
+    n[0] = 1.0;
+
+    Real     s0{ 0.0 }; // :norm of p[0]
+    Real     sp{ 1.0 }; // :norm of p[j-1]
+    unsigned j { 0   };
+    for( ; j < N and j < L; j++ ){
+      Real s{ 0.0 }, sx{ 0.0 }, sy{ 0.0 };
+      for( unsigned k = 0; k < L; k++ ){
+        const Real wv { W ? W[k]*v[k] : v[k] };
+        s  += wv*v[k];
+        sx += wv*v[k]*X[k];
+        sy += wv*Y[k];
+      }
+      if( j == 0 ) s0 = s;
+      if( not ( s > Real( N*N )*EPS*EPS*s0 ) ) break; // :p[j] vanishes in all sample points
+      const Real cj{ sy/s };
+      for( unsigned i = 0; i <= j; i++ ) c[i] += cj*n[i];
+      if( j+1 == N ) { j++; break; }
+                                                                                                                              /*
+      Next orthogonal polynomial in sample points and its monomial coefficients:
+                                                                                                                              */
+      const Real a{ sx/s              };
+      const Real b{ j > 0 ? s/sp : 0.0 };
+      for( unsigned k = 0; k < L; k++ ){
+        const Real w{ ( X[k] - a )*v[k] - b*u[k] };
+        u[k] = v[k];
+        v[k] = w;
+      }
+      for( unsigned i = j+1; i > 0; i-- ){
+        const Real w{ n[ i-1 ] - a*n[i] - b*m[i] };
+        m[i] = n[i];
+        n[i] = w;
+      }
+      {
+        const Real w{ -a*n[0] - b*m[0] };
+        m[0] = n[0];
+        n[0] = w;
+      }
+      sp = s;
+    }
+                                                                                                                              /*
+    Polynomial keeps coefficients from the highest degree:
+                                                                                                                              */
+    Real C[ N ];
+    for( unsigned i = 0; i < N; i++ ) C[i] = c[ N-1-i ];
+    P = Polynomial< N, Real >( C );
+    return j;
+  }
+
+}//CoreAGI
+
+#endif // FORSYTHE_H_INCLUDED
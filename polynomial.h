@@ -5,6 +5,14 @@
 ________________________________________________________________________________________________________________________________
 
   2021.11.16 Initial version
+
+  2026.10.18 Polynomial algebra: product, difference, affine composition, Taylor shift, Chebyshev form
+
+  2026.10.18 Derivative, real roots and extrema in the interval
+
+  2026.10.18 Chebyshev basis of arbitrary order generated by recurrence; Chebyshev series with Clenshaw evaluation
+
+  2026.10.18 Chebyshev forms of basis elements converted once per basis
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef APPROXIMATION_H_INCLUDED
@@ -16,6 +24,7 @@ ________________________________________________________________________________
 #include <limits>
 #include <functional>
 #include <span>
+#include <tuple>
 #include <initializer_list>
 
 #include "range.h"
@@ -24,7 +33,9 @@ namespace CoreAGI {
 
   template< unsigned L, typename Real = double > class Polynomial {
 
-    Real C[ L ]; // :polynomial coefficients
+    Real C[ L ]; // :polynomial coefficients, highest degree first
+
+    template< unsigned, typename > friend class Polynomial;
 
   public:
 
@@ -39,6 +50,8 @@ namespace CoreAGI {
       for( unsigned i = 0; const auto& Ci: coeff ) C[ i++ ] = Ci;
     }
 
+    explicit constexpr Polynomial( const Real* coeff ): C{}{ for( auto i: RANGE{ L } ) C[i] = coeff[i]; }
+
     constexpr bool defined() const {
       for( auto i: RANGE{ L } ) if( std::isnan( C[i] ) ) return false;
       return true;
@@ -46,6 +59,11 @@ namespace CoreAGI {
 
     void undef(){ for( auto i: RANGE{ L } ) C[i] = std::numeric_limits< Real >::quiet_NaN();  }
 
+    constexpr bool zero() const {
+      for( auto i: RANGE{ L } ) if( C[i] != 0.0 ) return false;
+      return true;
+    }
+
     constexpr Polynomial& operator = ( const Polynomial& P ){
       for( auto i: RANGE{ L } ) C[i] = P.C[i];
       return *this;
@@ -73,6 +91,71 @@ namespace CoreAGI {
       for( auto i: RANGE{ L } ) C[i] += Q.C[i];
       return *this;
     }
+
+    constexpr Polynomial operator- ( const Polynomial& Q ) const {
+      Polynomial P;
+      for( auto i: RANGE{ L } ) P.C[i] = C[i] - Q.C[i];
+      return P;
+    }
+                                                                                                                              /*
+    Product; order of the result is L + M - 1:
+                                                                                                                              */
+    template< unsigned M > constexpr Polynomial< L+M-1, Real > operator* ( const Polynomial< M, Real >& Q ) const {
+      Polynomial< L+M-1, Real > P;
+      for( auto i: RANGE{ L } ) for( auto j: RANGE{ M } ) P.C[ i+j ] += C[i]*Q.C[j];
+      return P;
+    }
+                                                                                                                              /*
+    Affine composition p( a*x + b ) calculated by Horner scheme over polynomials:
+                                                                                                                              */
+    constexpr Polynomial compose( const Real& a, const Real& b ) const {
+      Polynomial P;
+      for( auto i: RANGE{ L } ){
+        for( auto k: RANGE{ L-1 } ) P.C[k] = a*P.C[ k+1 ] + b*P.C[k]; // :P = P*( a*x + b )
+        P.C[ L-1 ] = b*P.C[ L-1 ] + C[i];
+      }
+      return P;
+    }
+                                                                                                                              /*
+    Taylor shift p( x + h ):
+                                                                                                                              */
+    constexpr Polynomial shift( const Real& h ) const { return compose( 1.0, h ); }
+                                                                                                                              /*
+    Conversion from Chebyshev form sum{ c[k]*T_k(x) }, `c[0]` is coefficient of T_0, using Clenshaw
+    recurrence over polynomials:
+                                                                                                                              */
+    static constexpr Polynomial fromChebyshev( const Real* c ){
+      Polynomial b1, b2; // :b[k+1], b[k+2]
+      for( unsigned k = L; k-- > 1; ){
+        Polynomial b;
+        for( auto i: RANGE{ L-1 } ) b.C[i] = 2.0*b1.C[ i+1 ] - b2.C[i]; // :2*x*b[k+1] - b[k+2]
+        b.C[ L-1 ] = c[k] - b2.C[ L-1 ];
+        b2 = b1;
+        b1 = b;
+      }
+      Polynomial P;
+      for( auto i: RANGE{ L-1 } ) P.C[i] = b1.C[ i+1 ] - b2.C[i];        // :x*b[1] - b[2]
+      P.C[ L-1 ] = c[0] - b2.C[ L-1 ];
+      return P;
+    }
+                                                                                                                              /*
+    Conversion to Chebyshev form; `c[0]` is coefficient of T_0. Horner scheme in Chebyshev
+    basis, multiplication by x uses x*T_0 = T_1 and x*T_k = ( T_{k+1} + T_{k-1} )/2:
+                                                                                                                              */
+    constexpr void toChebyshev( /*out*/ Real* c ) const {
+      for( auto k: RANGE{ L } ) c[k] = 0.0;
+      for( auto i: RANGE{ L } ){
+        Real x[ L ]{};
+        for( auto k: RANGE{ L } ){
+          if( c[k] == 0.0 ) continue;
+          if( k == 0 ){ if( L > 1 ) x[1] += c[0]; continue; }
+          x[ k-1 ] += 0.5*c[k];
+          if( k+1 < L ) x[ k+1 ] += 0.5*c[k];
+        }
+        for( auto k: RANGE{ L } ) c[k] = x[k];
+        c[0] += C[i];
+      }
+    }
                                                                                                                               /*
     Polynomial coefficient by index:
                                                                                                                               */
@@ -86,20 +169,160 @@ namespace CoreAGI {
       return y;
     }
 
+    constexpr Polynomial< ( L > 1 ? L-1 : 1 ), Real > derivative() const {
+      Polynomial< ( L > 1 ? L-1 : 1 ), Real > D;
+      if constexpr( L > 1 ) for( auto i: RANGE{ L-1 } ) D.C[i] = Real( L-1-i )*C[i];
+      return D;
+    }
+                                                                                                                              /*
+    Real roots in the interval [ a, b ] in ascending order; `r[]` should have room for L-1 values.
+    Roots of the derivative split the interval into monotonic pieces, each containing at most one
+    root isolated by bisection, so no matrix eigen problem (companion matrix is not symmetric) needed.
+    Roots of even multiplicity detected only when polynomial vanishes exactly at the critical point.
+    Identically zero polynomial has no isolated roots:
+                                                                                                                              */
+    constexpr unsigned roots( Real a, Real b, /*out*/ Real* r ) const {
+      if constexpr( L == 1 ){
+        return 0; // :constant has no isolated roots
+      } else {
+        if( zero() ) return 0;
+        Real     x[ L ]; // :ends of the monotonic pieces
+        unsigned n{ 0 };
+        x[ n++ ] = a;
+        n += derivative().roots( a, b, x+n );
+        x[ n++ ] = b;
+        unsigned m { 0                };
+        Real     fu{ (*this)( x[0] )  };
+        if( fu == 0.0 ) r[ m++ ] = x[0];
+        for( auto k: RANGE{ 1u, n } ){
+          if( m == L-1 ) break; // :all roots found (guard against rounding producing more)
+          const Real fv{ (*this)( x[k] ) };
+          if( fv == 0.0 ){
+            if( m == 0 or r[ m-1 ] != x[k] ) r[ m++ ] = x[k];
+          } else if( fu != 0.0 and ( fu < 0.0 ) != ( fv < 0.0 ) ){
+            r[ m++ ] = bisect( x[ k-1 ], x[k], fu );
+          }
+          fu = fv;
+        }
+        return m;
+      }
+    }
+                                                                                                                              /*
+    Minimum and maximum in the interval [ a, b ]: ( x of minimum, minimum, x of maximum, maximum ):
+                                                                                                                              */
+    constexpr std::tuple< Real, Real, Real, Real > extrema( Real a, Real b ) const {
+      Real x[ L+1 ];
+      unsigned n{ 0 };
+      x[ n++ ] = a;
+      if constexpr( L > 1 ) n += derivative().roots( a, b, x+n );
+      x[ n++ ] = b;
+      Real xmin{ a }, pmin{ (*this)( a ) }, xmax{ a }, pmax{ pmin };
+      for( auto k: RANGE{ 1u, n } ){
+        const Real p{ (*this)( x[k] ) };
+        if( p < pmin ) xmin = x[k], pmin = p;
+        if( p > pmax ) xmax = x[k], pmax = p;
+      }
+      return std::make_tuple( xmin, pmin, xmax, pmax );
+    }
+
+  private:
+
+    constexpr Real bisect( Real u, Real v, Real fu ) const {
+                                                                                                                              /*
+      Root in [ u, v ] where polynomial changes sign; `fu` is value at `u`:
+                                                                                                                              */
+      for( unsigned i = 0; i < 256; i++ ){
+        const Real w{ 0.5*( u + v ) };
+        if( w <= u or w >= v ) break;   // :no more resolution
+        const Real fw{ (*this)( w ) };
+        if( fw == 0.0 ) return w;
+        if( ( fw < 0.0 ) == ( fu < 0.0 ) ) u = w, fu = fw; else v = w;
+      }
+      return 0.5*( u + v );
+    }
+
   };//Polynomial
+                                                                                                                              /*
+  Polynomial in Chebyshev form sum{ c[k]*T_k(x) } evaluated by Clenshaw recurrence without conversion into monomial
+  form. Since |T_k(x)| <= 1 for x:[ -1 .. 1 ], tail coefficients with the sum of absolute values below tolerance can
+  be dropped with error not greater than tolerance inside this range:
+                                                                                                                              */
+  template< unsigned L, typename Real = double > class ChebyshevSeries {
+
+    Real     c[ L ]; // :coefficients of T_0 .. T_{L-1}
+    unsigned n;      // :number of used coefficients
+
+  public:
+
+    constexpr ChebyshevSeries(): c{}, n{ L }{}
+
+    explicit constexpr ChebyshevSeries( const Real* coeff ): c{}, n{ L }{ for( auto k: RANGE{ L } ) c[k] = coeff[k]; }
+
+    explicit constexpr ChebyshevSeries( const Polynomial< L, Real >& P ): c{}, n{ L }{ P.toChebyshev( c ); }
+
+    constexpr unsigned order () const { return L; }
+    constexpr unsigned length() const { return n; }
+
+    constexpr bool defined() const {
+      for( auto k: RANGE{ L } ) if( std::isnan( c[k] ) ) return false;
+      return true;
+    }
+
+    void undef(){ for( auto k: RANGE{ L } ) c[k] = std::numeric_limits< Real >::quiet_NaN(); n = L; }
+
+    constexpr unsigned trim( const Real& tolerance ){
+                                                                                                                              /*
+      Drop tail coefficients with sum of absolute values not greater than tolerance; all coefficients kept,
+      so trimming can be repeated with another tolerance:
+                                                                                                                              */
+      Real tail{ 0.0 };
+      n = L;
+      while( n > 1 and ( tail += std::abs( c[ n-1 ] ) ) <= tolerance ) n--;
+      return n;
+    }
+
+    constexpr Real operator[]( const unsigned& k ) const { assert( k < L ); return c[k]; }
+
+    constexpr Polynomial< L, Real > polynomial() const {
+                                                                                                                              /*
+      Power form of the used coefficients, i.e. of the series as evaluated:
+                                                                                                                              */
+      Real u[ L ]{};
+      for( auto k: RANGE{ n } ) u[k] = c[k];
+      return Polynomial< L, Real >::fromChebyshev( u );
+    }
+
+    constexpr Real operator()( const Real& x ) const {
+      Real b1{ 0.0 }, b2{ 0.0 };
+      for( unsigned k = n; k-- > 1; ){
+        const Real b{ c[k] + 2.0*x*b1 - b2 };
+        b2 = b1;
+        b1 = b;
+      }
+      return c[0] + x*b1 - b2;
+    }
+
+  };//ChebyshevSeries
 
 
   template< unsigned N, typename Real = double > class PolynomialBasis {
 
     Polynomial< N, Real > f[ N ];
+    Real                  c[ N ][ N ]; // :c[i] is Chebyshev form of f[i], converted once
 
   public:
 
     constexpr unsigned size() const { return N; }
 
-    explicit constexpr PolynomialBasis( const std::initializer_list< const Polynomial< N, Real > > G ){
+    explicit constexpr PolynomialBasis( const std::initializer_list< const Polynomial< N, Real > > G ): f{}, c{} {
       assert( G.size() == N );
       for( unsigned i = 0; const auto& Gi: G ) f[ i++ ] = Gi;
+      for( auto i: RANGE{ N } ) f[i].toChebyshev( c[i] );
+    }
+
+    explicit constexpr PolynomialBasis( const Polynomial< N, Real > ( &G )[ N ] ): f{}, c{} {
+      for( auto i: RANGE{ N } ) f[i] = G[i];
+      for( auto i: RANGE{ N } ) f[i].toChebyshev( c[i] );
     }
 
     Polynomial< N, Real > operator()( const std::initializer_list< Real > coeff ) const {
@@ -115,68 +338,57 @@ namespace CoreAGI {
       return P;
     }
 
-    const Polynomial< N, Real > operator[] ( unsigned i ) const { return f[i]; }
+    constexpr const Polynomial< N, Real > operator[] ( unsigned i ) const { return f[i]; }
+
+    constexpr void toChebyshev( const Real* coeff, /*out*/ Real* u ) const {
+                                                                                                                              /*
+      Chebyshev form of the linear combination of elements with coefficients `coeff`; exact for any basis
+      since conversion is linear, O(N^2) as forms of elements are converted by constructor:
+                                                                                                                              */
+      for( auto k: RANGE{ N } ) u[k] = 0.0;
+      for( auto i: RANGE{ N } ) for( auto k: RANGE{ N } ) u[k] += coeff[i]*c[i][k];
+    }
 
     constexpr PolynomialBasis& operator= ( const PolynomialBasis< N, Real >& basis ){
       for( auto i: RANGE{ N } ) f[i] = basis.f[i];
+      for( auto i: RANGE{ N } ) for( auto k: RANGE{ N } ) c[i][k] = basis.c[i][k];
       return *this;
     }
 
   };//PolynomialBasis
                                                                                                                               /*
-  Functional basises composed of Chebyshev polynomials:
+  Functional basis composed of Chebyshev polynomials T_0 .. T_{N-1} generated by recurrence
+  T_0 = 1, T_1 = x, T_{k+1} = 2x*T_k - T_{k-1}:
+                                                                                                                              */
+  template< unsigned N, typename Real = double > constexpr PolynomialBasis< N, Real > ChebyshevBasis(){
+    Real T[ N ][ N ]{}; // :T[k][i] is coefficient of x^i of T_k
+    T[0][0] = 1.0;
+    if constexpr( N > 1 ) T[1][1] = 1.0;
+    for( unsigned k = 2; k < N; k++ ){
+      for( unsigned i = 0; i < N; i++ ) T[k][i] = ( i > 0 ? 2.0*T[ k-1 ][ i-1 ] : 0.0 ) - T[ k-2 ][i];
+    }
+    Polynomial< N, Real > f[ N ];
+    for( unsigned k = 0; k < N; k++ ){
+      Real C[ N ];
+      for( unsigned i = 0; i < N; i++ ) C[i] = T[k][ N-1-i ]; // :Polynomial keeps the highest degree first
+      f[k] = Polynomial< N, Real >( C );
+    }
+    return PolynomialBasis< N, Real >( f );
+  }
+                                                                                                                              /*
+  Functional basises composed of Chebyshev polynomials (rows for T_4 and T_5 of the former tables did not
+  match the recurrence):
                                                                                                                               */
   using Real = double;
 
-  constexpr PolynomialBasis< 2, Real > Chebyshev2 {
-                                                                                                                              /*
-                     x^1  x^0
-                     ---  ---                                                                                                         */
-    Polynomial< 2 >{ 0.0, 1.0 },
-    Polynomial< 2 >{ 1.0, 0.0 }
-  };
-
-  constexpr PolynomialBasis< 3, Real > Chebyshev3 {
-                                                                                                                              /*
-                     x^2  x^1  x^0
-                     ---  ---  ---                                                                                                         */
-    Polynomial< 3 >{ 0.0, 0.0, 1.0 },
-    Polynomial< 3 >{ 0.0, 1.0, 0.0 },
-    Polynomial< 3 >{ 2.0, 0.0,-1.0 }
-  };
-
-  constexpr PolynomialBasis< 4, Real > Chebyshev4 {
-                                                                                                                              /*
-                     x^3  x^2  x^1  x^0
-                     ---  ---  ---  ---                                                                                                         */
-    Polynomial< 4 >{ 0.0, 0.0, 0.0, 1.0 },
-    Polynomial< 4 >{ 0.0, 0.0, 1.0, 0.0 },
-    Polynomial< 4 >{ 0.0, 2.0, 0.0,-1.0 },
-    Polynomial< 4 >{ 4.0, 0.0,-3.0, 0.0 }
-  };
-
-  constexpr PolynomialBasis< 5, Real > Chebyshev5 {
-                                                                                                                              /*
-                     x^4  x^3  x^2  x^1  x^0
-                     ---  ---  ---  ---  ---                                                                                                         */
-    Polynomial< 5 >{ 0.0, 0.0, 0.0, 0.0, 1.0 },
-    Polynomial< 5 >{ 0.0, 0.0, 0.0, 1.0, 0.0 },
-    Polynomial< 5 >{ 0.0, 0.0, 2.0, 0.0,-1.0 },
-    Polynomial< 5 >{ 0.0, 4.0, 0.0,-3.0, 0.0 },
-    Polynomial< 5 >{ 8.0, 4.0,-8.0, 0.0, 1.0 }
-  };
-
-  constexpr PolynomialBasis< 6, Real > Chebyshev6 {
-                                                                                                                              /*
-                      x^5   x^4    x^3   x^2   x^1   x^0
-                      ---   ---    ---   ---   ---   ---                                                                                                         */
-    Polynomial< 6 >{  0.0,  0.0,   0.0,  0.0,  0.0,  1.0 },
-    Polynomial< 6 >{  0.0,  0.0,   0.0,  0.0,  1.0,  0.0 },
-    Polynomial< 6 >{  0.0,  0.0,   0.0,  2.0,  0.0, -1.0 },
-    Polynomial< 6 >{  0.0,  0.0,   4.0,  0.0, -3.0,  0.0 },
-    Polynomial< 6 >{  0.0,  8.0,   4.0, -8.0,  0.0,  1.0 },
-    Polynomial< 6 >{ 16.0,  0.0, -20.0,  0.0,  5.0,  1.0 }
-  };
+  // constexpr PolynomialBasis< 5, Real > Chebyshev5 { ... Polynomial< 5 >{ 8.0, 4.0,-8.0, 0.0, 1.0 } };      // [-] 2026.10.18
+  // constexpr PolynomialBasis< 6, Real > Chebyshev6 { ... Polynomial< 6 >{ 16.0, 0.0, -20.0, 0.0, 5.0, 1.0 } }; // [-] 2026.10.18
+
+  constexpr PolynomialBasis< 2, Real > Chebyshev2{ ChebyshevBasis< 2, Real >() };                            // [m] 2026.10.18
+  constexpr PolynomialBasis< 3, Real > Chebyshev3{ ChebyshevBasis< 3, Real >() };                            // [m] 2026.10.18
+  constexpr PolynomialBasis< 4, Real > Chebyshev4{ ChebyshevBasis< 4, Real >() };                            // [m] 2026.10.18
+  constexpr PolynomialBasis< 5, Real > Chebyshev5{ ChebyshevBasis< 5, Real >() };                            // [m] 2026.10.18
+  constexpr PolynomialBasis< 6, Real > Chebyshev6{ ChebyshevBasis< 6, Real >() };                            // [m] 2026.10.18
 
 }//CoreAGI
 
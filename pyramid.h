@@ -0,0 +1,147 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version: levels of decimated samples fed by single ingest, own fit cadence per level
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef PYRAMID_H_INCLUDED
+#define PYRAMID_H_INCLUDED
+
+#include <cassert>
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "dynamic.h"
+#include "range.h"
+
+namespace CoreAGI {
+                                                                                                                              /*
+  Multi-resolution approximation of single signal. Level 0 receives samples as is; each sample of level
+  `k+1` is the weighted mean (time and value) of RATIO consecutive samples of level `k` with summary weight,
+  so all levels have the same capacity and cost, but level `k` covers RATIO^k times longer time range.
+
+  Level `k` is refitted by `process` after CADENCE[k] new samples; by default coarser levels that receive
+  RATIO times less samples are refitted RATIO times less often. Query selects the finest level whose
+  extrapolation horizon `Tx` covers the requested time.
+                                                                                                                              */
+  template< unsigned N, typename Real = double, Layout LAYOUT = Layout::COMPACT > class DynamicPyramid {
+
+    using Time  = double;
+    using Level = Dynamic< N, Real, LAYOUT >;
+
+    struct Accumulator {
+      Time     t;     // :sum of weighted times
+      Real     v;     // :sum of weighted values
+      Real     w;     // :sum of weights
+      unsigned n;     // :number of aggregated samples
+      unsigned fresh; // :number of samples of the level since its last fit
+    };
+
+    const unsigned             RATIO;   // :decimation factor between neighbouring levels
+    std::vector< Level       > D;       // :levels, from the finest
+    mutable std::mutex         mutexA;  // :protects A, CADENCE
+    std::vector< Accumulator > A;       // :A[k] aggregates samples of level k-1 into sample of level k
+    std::vector< unsigned    > CADENCE; // :number of new samples of the level that triggers its fit
+
+  public:
+
+    DynamicPyramid( unsigned levels, unsigned capacity, unsigned ratio, const PolynomialBasis< N, Real >& basis ):
+      RATIO  { ratio                 },
+      D      {                       },
+      mutexA {                       },
+      A      ( levels, Accumulator{} ),
+      CADENCE( levels, 1u            )
+    {
+      if( levels == 0 or ratio < 2 ) throw std::invalid_argument( "At least one level and ratio above 1 required" );
+      D.reserve( levels );
+      for( auto k: RANGE{ levels } ){ (void)k; D.emplace_back( capacity, basis ); }
+    }
+
+    DynamicPyramid( const DynamicPyramid& ) = delete;
+    DynamicPyramid& operator= ( const DynamicPyramid& ) = delete;
+
+    unsigned levels() const { return unsigned( D.size() ); }
+
+    unsigned ratio() const { return RATIO; }
+
+          Level& operator[] ( unsigned k )       { assert( k < levels() ); return D[k]; }
+    const Level& operator[] ( unsigned k ) const { assert( k < levels() ); return D[k]; }
+                                                                                                                              /*
+    Level `k` refitted after each `every` new samples of the level:
+                                                                                                                              */
+    void cadence( unsigned k, unsigned every ){
+      assert( k < levels() );
+      const std::lock_guard< std::mutex > lock( mutexA );
+      CADENCE[k] = every > 0 ? every : 1;
+    }
+                                                                                                                              /*
+    Single ingest: sample goes into level 0 and, aggregated, into coarser levels; returns number of levels
+    that received sample:
+                                                                                                                              */
+    unsigned update( const Time& t, const Real& v, const Real& w = 1.0 ){
+      const std::lock_guard< std::mutex > lock( mutexA );
+      Time     tk{ t };
+      Real     vk{ v };
+      Real     wk{ w };
+      unsigned k { 0 };
+      while( true ){
+        D[k].update( tk, vk, wk );
+        A[k].fresh++;
+        if( ++k == levels() ) break;
+        Accumulator& a{ A[k] };
+        a.t += wk*tk;
+        a.v += wk*vk;
+        a.w += wk;
+        if( ++a.n < RATIO ) break;
+        tk = a.t/a.w;
+        vk = a.v/a.w;
+        wk = a.w;
+        a.t = 0.0, a.v = 0.0, a.w = 0.0, a.n = 0;
+      }
+      return k;
+    }
+                                                                                                                              /*
+    Fit levels that received CADENCE new samples since their previous fit; returns number of fitted levels:
+                                                                                                                              */
+    unsigned process(){
+      bool due[ levels() ];
+      {
+        const std::lock_guard< std::mutex > lock( mutexA );
+        for( auto k: RANGE{ levels() } ){
+          due[k] = A[k].fresh >= CADENCE[k];
+          if( due[k] ) A[k].fresh = 0;
+        }
+      }
+      unsigned n{ 0 };
+      for( auto k: RANGE{ levels() } ) if( due[k] ){ D[k].process(); n++; }
+      return n;
+    }
+                                                                                                                              /*
+    The finest level whose approximation covers time `t` (extrapolation horizon `Tx` not less than `t`);
+    the coarsest defined level if none covers it:
+                                                                                                                              */
+    unsigned level( const Time& t ) const {
+      unsigned coarsest{ 0 };
+      for( auto k: RANGE{ levels() } ){
+        const auto[ P, To, Tt, Tx ] = D[k].def();
+        if( not P.defined() ) continue;
+        if( t <= Tx ) return k;
+        coarsest = k;
+      }
+      return coarsest;
+    }
+
+    Real operator() ( const Time& t, RangePoint* note = nullptr ){
+      return D[ level( t ) ]( t, note );
+    }
+
+  };//DynamicPyramid
+
+}//CoreAGI
+
+#endif // PYRAMID_H_INCLUDED
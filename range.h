@@ -12,6 +12,8 @@ ________________________________________________________________________________
 #ifndef RANGE_H_INCLUDED
 #define RANGE_H_INCLUDED
 
+#include <cassert>
+
 #include <type_traits>
 
 template< typename Elem = unsigned > class RANGE {
@@ -0,0 +1,343 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version: sharded open addressing registry of keyed channels with slab storage of queues
+
+  2026.10.18 Serial numbers of channels; incremental save into checkpoint and load from snapshot
+
+  2026.10.18 Load into non-empty registry: clashing serial numbers reassigned, stale records invalidated
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef REGISTRY_H_INCLUDED
+#define REGISTRY_H_INCLUDED
+
+#include <cassert>
+#include <cstdint>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "cacheline.h"
+#include "range.h"
+
+namespace CoreAGI {
+                                                                                                                              /*
+  Registry of channels (e.g. `Dynamic` instances) identified by keys (e.g. sensor ID).
+
+  Keys are distributed between shards by hash; each shard has own mutex, own open addressing (linear probing)
+  hash table, own storage of channels and own list of dirty channels, so ingest threads routing samples of
+  different keys rarely meet on the same mutex. The shard mutex is held only for lookup; the channel itself
+  is updated outside of it, synchronized by the channel.
+
+  Queues of samples of channels created by the registry are taken from slabs of the shard: storage of samples
+  is allocated once per SLAB channels instead of once per channel; slab is released when the last queue
+  placed in it released. Each queue still has own small control block (see `ring`).
+
+  Channels are never removed and never relocated, so references returned by the registry stay valid during
+  its lifetime. Each channel has serial number (order of creation) used as index of its checkpoint record.
+                                                                                                                              */
+  template< typename Key, typename Channel, typename Hash = std::hash< Key > > class Registry {
+
+    using Time   = typename Channel::Time;
+    using Value  = typename Channel::Value;
+    using Basis  = typename Channel::Basis;
+    using Sample = typename Channel::Sample;
+    using Ring   = typename Channel::Ring;
+
+    static constexpr unsigned SLAB { 256  }; // :number of queues in slab
+    static constexpr unsigned EMPTY{ ~0u  }; // :free slot of hash table
+
+    struct Entry {
+      const Key           key;
+      const unsigned      serial;  // :serial number of the channel
+      Channel             D;
+      std::atomic< bool > dirty;   // :queued in the list of dirty channels of the shard
+      std::atomic< bool > unsaved; // :updated since the last save
+      Entry( const Key& key, unsigned serial, unsigned capacity, const Basis& basis, Ring ring ):
+        key{ key }, serial{ serial }, D{ capacity, basis, std::move( ring ) }, dirty{ false }, unsaved{ false }
+      {}
+    };
+
+    struct alignas( CACHE_LINE ) Shard {
+      std::mutex                  mutex;   // :protects all below
+      std::vector< unsigned >     table;   // :indices of entries or EMPTY; size is power of 2
+      std::deque < Entry >        entries; // :channels of the shard; deque never relocates elements
+      std::vector< unsigned >     dirty;   // :indices of entries updated since the last `dirty` call
+      std::shared_ptr< Sample[] > slab;    // :current slab of queues
+      unsigned                    used;    // :number of queues taken from the current slab
+      Shard(): mutex{}, table( 16, EMPTY ), entries{}, dirty{}, slab{}, used{ SLAB }{}
+    };
+
+    const unsigned             CAPACITY; // :queue capacity of channels
+    const Basis&               F;        // :functional basis of channels
+    const unsigned             SHIFT;    // :64 minus number of hash bits used to select shard
+    std::unique_ptr< Shard[] > shard;
+    std::mutex                 mutexS;   // :protects owner, stale
+    std::vector< Entry*      > owner;    // :channel of each serial number, `nullptr` if serial not used
+    std::vector< unsigned    > stale;    // :checkpoint records to be invalidated by the next `save`
+
+    static std::uint64_t mix( std::uint64_t h ){
+                                                                                                                              /*
+      Finalizer of MurmurHash3: `std::hash` of integers is identity, low and high bits must be scattered:
+                                                                                                                              */
+      h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+    }
+
+    static unsigned log2( unsigned n ){
+      unsigned k{ 0 };
+      while( ( 1u << k ) < n ) k++;
+      return k;
+    }
+
+    Shard& select( std::uint64_t h ) const { return shard[ SHIFT < 64 ? h >> SHIFT : 0 ]; }
+
+    Ring ring( Shard& s ){
+      if( s.used == SLAB ){
+        s.slab = std::make_shared< Sample[] >( std::size_t( SLAB )*CAPACITY );
+        s.used = 0;
+      }
+                                                                                                                              /*
+      Queue shares the control block of the slab (aliasing constructor), so the slab lives while any of its
+      queues does; copy-on-write of `Dynamic` tracks copies itself and does not rely on `use_count`:
+                                                                                                                              */
+      Sample* r{ s.slab.get() + std::size_t( s.used++ )*CAPACITY };
+      return Ring( s.slab, r );
+    }
+                                                                                                                              /*
+    Lookup in the table of the shard; returns index of the slot with the key or of the free slot:
+                                                                                                                              */
+    static unsigned probe( const Shard& s, const Key& key, std::uint64_t h ){
+      const unsigned mask{ unsigned( s.table.size() ) - 1 };
+      unsigned i{ unsigned( h ) & mask };
+      while( s.table[i] != EMPTY and not ( s.entries[ s.table[i] ].key == key ) ) i = ( i + 1 ) & mask;
+      return i;
+    }
+
+    static void grow( Shard& s ){
+      std::vector< unsigned > table( 2*s.table.size(), EMPTY );
+      const unsigned mask{ unsigned( table.size() ) - 1 };
+      for( auto k: RANGE{ unsigned( s.entries.size() ) } ){
+        unsigned i{ unsigned( mix( Hash{}( s.entries[k].key ) ) ) & mask };
+        while( table[i] != EMPTY ) i = ( i + 1 ) & mask;
+        table[i] = k;
+      }
+      s.table.swap( table );
+    }
+                                                                                                                              /*
+    Index of the channel of the key in the shard, channel created if absent (with the next serial number
+    unless `serial` given and not used by other channel); shard must be locked:
+                                                                                                                              */
+    unsigned locate( Shard& s, const Key& key, std::uint64_t h, unsigned serial = EMPTY ){
+      unsigned i{ probe( s, key, h ) };
+      if( s.table[i] != EMPTY ) return s.table[i];
+      if( 2*( s.entries.size() + 1 ) > s.table.size() ){ // :load factor kept below 1/2
+        grow( s );
+        i = probe( s, key, h );
+      }
+      const std::lock_guard< std::mutex > lock( mutexS );
+      if( serial == EMPTY or ( serial < owner.size() and owner[ serial ] ) ) serial = unsigned( owner.size() );
+      if( serial >= owner.size() ) owner.resize( serial + 1, nullptr );
+      s.entries.emplace_back( key, serial, CAPACITY, F, ring( s ) );
+      owner[ serial ] = &s.entries.back();
+      return s.table[i] = unsigned( s.entries.size() - 1 );
+    }
+
+  public:
+
+    Registry( unsigned capacity, const Basis& basis, unsigned shards = 64 ):
+      CAPACITY{ capacity                                        },
+      F       { basis                                           },
+      SHIFT   { 64 - log2( shards > 0 ? shards : 1 )            },
+      shard   { new Shard[ std::size_t( 1 ) << ( 64 - SHIFT ) ] },
+      mutexS  {                                                 },
+      owner   {                                                 },
+      stale   {                                                 }
+    {}
+
+    Registry( const Registry& ) = delete;
+    Registry& operator= ( const Registry& ) = delete;
+                                                                                                                              /*
+    Number of shards (power of 2):
+                                                                                                                              */
+    unsigned shards() const { return 1u << ( 64 - SHIFT ); }
+                                                                                                                              /*
+    Number of channels:
+                                                                                                                              */
+    std::size_t size() const {
+      std::size_t n{ 0 };
+      for( auto k: RANGE{ shards() } ){
+        const std::lock_guard< std::mutex > lock( shard[k].mutex );
+        n += shard[k].entries.size();
+      }
+      return n;
+    }
+                                                                                                                              /*
+    Channel of the key, created if absent:
+                                                                                                                              */
+    Channel& operator[] ( const Key& key ){
+      const std::uint64_t h{ mix( Hash{}( key ) ) };
+      Shard& s{ select( h ) };
+      const std::lock_guard< std::mutex > lock( s.mutex );
+      return s.entries[ locate( s, key, h ) ].D;
+    }
+                                                                                                                              /*
+    Channel of the key or `nullptr` if absent:
+                                                                                                                              */
+    Channel* find( const Key& key ){
+      const std::uint64_t h{ mix( Hash{}( key ) ) };
+      Shard& s{ select( h ) };
+      const std::lock_guard< std::mutex > lock( s.mutex );
+      const unsigned i{ probe( s, key, h ) };
+      return s.table[i] == EMPTY ? nullptr : &s.entries[ s.table[i] ].D;
+    }
+                                                                                                                              /*
+    Ingest of the sample of the key: channel located (created if absent) under the shard mutex, updated
+    outside of it, and queued as dirty unless already queued; returns index of the shard:
+                                                                                                                              */
+    unsigned route( const Key& key, const Time& t, const Value& v ){
+      const std::uint64_t h{ mix( Hash{}( key ) ) };
+      Shard& s{ select( h ) };
+      unsigned index{ 0 };
+      Entry*   e    { nullptr };
+      {
+        const std::lock_guard< std::mutex > lock( s.mutex );
+        index = locate( s, key, h );
+        e     = &s.entries[ index ];
+      }
+      e->D.update( t, v );
+      e->unsaved.store( true );
+      if( not e->dirty.exchange( true ) ){
+        const std::lock_guard< std::mutex > lock( s.mutex );
+        s.dirty.push_back( index );
+      }
+      return unsigned( &s - shard.get() );
+    }
+                                                                                                                              /*
+    Calls `f( key, channel )` for each channel of the shard `k` updated since the previous call; flag of
+    the channel is reset before the call, so update concurrent with `f` queues the channel again. Returns
+    number of visited channels:
+                                                                                                                              */
+    template< typename Visitor > unsigned dirty( unsigned k, Visitor f ){
+      assert( k < shards() );
+      Shard& s{ shard[k] };
+      std::vector< unsigned > list;
+      std::vector< Entry*   > E;
+      {
+        const std::lock_guard< std::mutex > lock( s.mutex );
+        list.swap( s.dirty );
+        E.reserve( list.size() );
+        for( auto i: list ) E.push_back( &s.entries[i] );
+      }
+      for( auto e: E ){
+        e->dirty.store( false );
+        f( e->key, e->D );
+      }
+      return unsigned( E.size() );
+    }
+                                                                                                                              /*
+    Fits all dirty channels of the shard `k`; returns number of processed channels:
+                                                                                                                              */
+    unsigned process( unsigned k ){
+      return dirty( k, []( const Key&, Channel& D ){ D.process(); } );
+    }
+                                                                                                                              /*
+    Calls `f( key, channel )` for each channel of the shard `k`:
+                                                                                                                              */
+    template< typename Visitor > void forEach( unsigned k, Visitor f ){
+      assert( k < shards() );
+      Shard& s{ shard[k] };
+      std::vector< Entry* > E;
+      {
+        const std::lock_guard< std::mutex > lock( s.mutex );
+        E.reserve( s.entries.size() );
+        for( auto& e: s.entries ) E.push_back( &e );
+      }
+      for( auto e: E ) f( e->key, e->D );
+    }
+
+                                                                                                                              /*
+    Save channels updated since the previous save (all channels if `all`) into checkpoint `C` (record index
+    is serial number of the channel) and invalidate records left stale by `load`; returns number of saved
+    channels:
+                                                                                                                              */
+    template< typename Checkpoint > unsigned save( Checkpoint& C, bool all = false ){
+      std::vector< unsigned > invalid;
+      {
+        const std::lock_guard< std::mutex > lock( mutexS );
+        invalid.swap( stale );
+      }
+      for( auto k: RANGE{ unsigned( invalid.size() ) } ) if( not C.erase( invalid[k] ) ){
+        const std::lock_guard< std::mutex > lock( mutexS );
+        stale.insert( stale.end(), invalid.begin() + k, invalid.end() );
+        throw std::runtime_error( "Checkpoint can not be written" );
+      }
+      unsigned n{ 0 };
+      for( auto k: RANGE{ shards() } ){
+        Shard& s{ shard[k] };
+        std::vector< Entry* > E;
+        {
+          const std::lock_guard< std::mutex > lock( s.mutex );
+          E.reserve( s.entries.size() );
+          for( auto& e: s.entries ) E.push_back( &e );
+        }
+        for( auto e: E ) if( e->unsaved.exchange( false ) or all ){
+          if( not C.save( e->serial, e->key, e->D ) ){
+            e->unsaved.store( true );
+            throw std::runtime_error( "Checkpoint can not be written" );
+          }
+          n++;
+        }
+      }
+      return n;
+    }
+                                                                                                                              /*
+    Create (or overwrite) channels saved in the snapshot `S` keeping their serial numbers; returns number of
+    loaded channels. Registry may be not empty: existing channel of the key keeps its serial number, new
+    channel whose serial number is used by other channel gets new one. In both cases the channel is saved
+    into own record by the next `save`, and the records of the snapshot's serial number are invalidated
+    before (the channel owning the serial number, if any, is saved anew, so neither of its two records
+    keeps the state of the other key):
+                                                                                                                              */
+    template< typename Snapshot > unsigned load( const Snapshot& S ){
+      {
+        const std::lock_guard< std::mutex > lock( mutexS );
+        if( owner.size() < S.count() ) owner.resize( S.count(), nullptr ); // :new serials beyond records of `S`
+      }
+      unsigned n{ 0 };
+      for( auto i: RANGE{ S.count() } ) if( S.valid( i ) ){
+        const Key           key{ S.key( i ) };
+        const std::uint64_t h  { mix( Hash{}( key ) ) };
+        Shard& s{ select( h ) };
+        Entry* e{ nullptr };
+        {
+          const std::lock_guard< std::mutex > lock( s.mutex );
+          e = &s.entries[ locate( s, key, h, i ) ];
+        }
+        S.load( i, e->D );
+        if( e->serial != i ){
+          e->unsaved.store( true );
+          const std::lock_guard< std::mutex > lock( mutexS );
+          if( owner[i] ) owner[i]->unsaved.store( true );
+          stale.push_back( i );
+        }
+        n++;
+      }
+      return n;
+    }
+
+  };//Registry
+
+}//CoreAGI
+
+#endif // REGISTRY_H_INCLUDED
@@ -0,0 +1,298 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version: publication of fitted polynomials into POSIX shared memory, slots with seqlocks
+
+  2026.10.18 Publishers keep the mapping; bounded read retries; existing segment validated, not rewritten
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef SHMEM_H_INCLUDED
+#define SHMEM_H_INCLUDED
+
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cacheline.h"
+#include "polynomial.h"
+#include "range.h"
+
+namespace CoreAGI {
+                                                                                                                              /*
+  Shared memory segment: header followed by array of slots of fixed stride (whole cache lines), one slot per
+  channel. Each slot is written by single writer (the fitter of the channel) and protected by seqlock: the
+  sequence number is odd while the slot is written, so reader retries when it sees odd or changed number;
+  retries are bounded, so slot left odd by crashed writer reads as failure instead of hanging the reader.
+  All fields are lock-free atomics accessed with relaxed order between acquire/release fences, so neither
+  writer nor reader uses syscalls or locks (except yielding while retrying) and the segment can be mapped
+  by any number of processes; one writer process per segment.
+
+  Slot keeps polynomial `P` of mapped argument `x = 2( t - To )/( Tx - To ) - 1` and `To`, `Tt`, `Tx`,
+  the same as `Dynamic::def()`.
+                                                                                                                              */
+  namespace SharedMemory {
+
+    constexpr std::uint64_t MAGIC{ 0x434f524541474931ULL }; // :"COREAGI1"
+
+    struct Header {
+      std::uint64_t magic;
+      std::uint32_t order;  // :number of coefficients N
+      std::uint32_t real;   // :sizeof( Real )
+      std::uint64_t stride; // :size of slot, bytes
+      std::uint64_t count;  // :number of slots
+    };
+
+    template< unsigned N, typename Real > struct alignas( CACHE_LINE ) Slot {
+      std::atomic< std::uint64_t > seq;    // :odd while written, 0 if never written
+      std::atomic< double        > To;
+      std::atomic< double        > Tt;
+      std::atomic< double        > Tx;
+      std::atomic< Real          > C[ N ]; // :coefficients, highest degree first
+    };
+
+    constexpr std::size_t offset(){ return ( ( sizeof( Header ) + CACHE_LINE - 1 )/CACHE_LINE )*CACHE_LINE; }
+
+  }//SharedMemory
+                                                                                                                              /*
+  Writer side: creates named segment of `count` slots, or reuses existing one of compatible layout (header is
+  validated, not rewritten, so live readers are not disturbed; slots left odd by crashed writer are reset to
+  never written). Existing segment of other layout is not touched: constructor throws, `remove` it first:
+                                                                                                                              */
+  template< unsigned N, typename Real = double > class Publication {
+
+    using Time = double;
+    using Slot = SharedMemory::Slot< N, Real >;
+
+    static_assert( std::atomic< Real          >::is_always_lock_free, "Lock-free atomic type required" );
+    static_assert( std::atomic< std::uint64_t >::is_always_lock_free, "Lock-free atomic type required" );
+
+    const std::string       NAME;
+    const unsigned          COUNT;
+    std::size_t             size;
+    std::shared_ptr< void > map;  // :mapping of the segment, shared with publishers
+
+    Slot& slot( unsigned i ) const {
+      assert( i < COUNT );
+      return reinterpret_cast< Slot* >( static_cast< char* >( map.get() ) + SharedMemory::offset() )[i];
+    }
+
+    static void store( Slot& S, const Polynomial< N, Real >& P, const Time& To, const Time& Tt, const Time& Tx ){
+      const std::uint64_t seq{ S.seq.load( std::memory_order_relaxed ) };
+      S.seq.store( seq + 1, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_release );
+      S.To.store( To, std::memory_order_relaxed );
+      S.Tt.store( Tt, std::memory_order_relaxed );
+      S.Tx.store( Tx, std::memory_order_relaxed );
+      for( auto k: RANGE{ N } ) S.C[k].store( P[k], std::memory_order_relaxed );
+      S.seq.store( seq + 2, std::memory_order_release );
+    }
+
+  public:
+
+    Publication( const std::string& name, unsigned count ):
+      NAME { name                                                         },
+      COUNT{ count                                                        },
+      size { SharedMemory::offset() + std::size_t( count )*sizeof( Slot ) },
+      map  {                                                              }
+    {
+      int        fd     { shm_open( NAME.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644 ) };
+      const bool created{ fd >= 0 };
+      if( not created and errno == EEXIST ) fd = shm_open( NAME.c_str(), O_RDWR, 0 );
+      if( fd < 0 ) throw std::runtime_error( "Shared memory segment can not be opened: " + NAME );
+      struct stat st;
+      if( created ? ftruncate( fd, off_t( size ) ) != 0 : fstat( fd, &st ) != 0 ){
+        close( fd );
+        throw std::runtime_error( "Shared memory segment can not be resized: " + NAME );
+      }
+      if( not created and std::size_t( st.st_size ) < size ){
+        close( fd );
+        throw std::runtime_error( "Shared memory segment has incompatible layout: " + NAME );
+      }
+      void* base{ mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) };
+      close( fd );
+      if( base == MAP_FAILED ) throw std::runtime_error( "Shared memory segment can not be mapped: " + NAME );
+      map = std::shared_ptr< void >( base, [ size = size ]( void* p ){ munmap( p, size ); } );
+      auto  H    { static_cast< SharedMemory::Header* >( base ) };
+      auto& magic{ *reinterpret_cast< std::atomic< std::uint64_t >* >( &H->magic ) };
+      if( magic.load( std::memory_order_acquire ) == 0 ){ // :new segment, or creator failed before initialization
+        H->order  = N;
+        H->real   = sizeof( Real );
+        H->stride = sizeof( Slot );
+        H->count  = COUNT;
+        std::atomic_thread_fence( std::memory_order_release );
+        magic.store( SharedMemory::MAGIC, std::memory_order_release );
+        return;
+      }
+      const bool valid{
+        magic.load( std::memory_order_acquire ) == SharedMemory::MAGIC
+        and H->order  == N
+        and H->real   == sizeof( Real )
+        and H->stride == sizeof( Slot )
+        and H->count  >= COUNT
+      };
+      if( not valid ) throw std::runtime_error( "Shared memory segment has incompatible layout: " + NAME );
+      for( auto i: RANGE{ COUNT } ){
+        auto& seq{ slot( i ).seq };
+        if( seq.load( std::memory_order_relaxed ) & 1 ) seq.store( 0, std::memory_order_release ); // :torn by crashed writer
+      }
+    }
+
+    Publication( const Publication& ) = delete;
+    Publication& operator= ( const Publication& ) = delete;
+
+   ~Publication() = default;
+                                                                                                                              /*
+    Remove name of the segment; processes that mapped the segment keep it until unmapped:
+                                                                                                                              */
+    void remove() const { shm_unlink( NAME.c_str() ); }
+
+    unsigned count() const { return COUNT; }
+                                                                                                                              /*
+    Store approximation into the slot `i`; concurrent calls for the same slot must be serialized by caller
+    (`Dynamic` calls its publisher under own lock):
+                                                                                                                              */
+    void publish( unsigned i, const Polynomial< N, Real >& P, const Time& To, const Time& Tt, const Time& Tx ) const {
+      store( slot( i ), P, To, Tt, Tx );
+    }
+                                                                                                                              /*
+    Publisher for `Dynamic::publisher`: binds the slot `i` and shares the mapping, so it stays valid when
+    the `Publication` is destroyed before the channel:
+                                                                                                                              */
+    auto publisher( unsigned i ) const {
+      return [ map = map, S = &slot( i ) ]( const Polynomial< N, Real >& P, const Time& To, const Time& Tt, const Time& Tx ){
+        store( *S, P, To, Tt, Tx );
+      };
+    }
+
+  };//Publication
+                                                                                                                              /*
+  Reader side: maps existing segment read-only; throws if segment absent or has incompatible layout:
+                                                                                                                              */
+  template< unsigned N, typename Real = double > class Subscription {
+
+    using Time = double;
+    using Slot = SharedMemory::Slot< N, Real >;
+
+    std::size_t size;
+    unsigned    COUNT;
+    const void* base;
+
+    const Slot& slot( unsigned i ) const {
+      assert( i < COUNT );
+      return reinterpret_cast< const Slot* >( static_cast< const char* >( base ) + SharedMemory::offset() )[i];
+    }
+                                                                                                                              /*
+    Seqlock read: `f( slot )` repeated until the slot is not changed during the call; returns false if the
+    slot has never been written or is not stable after RETRIES attempts (writer crashed while writing, or
+    preempted for long); after SPIN attempts reader yields, so preempted writer on the same core can finish:
+                                                                                                                              */
+    static constexpr unsigned SPIN   { 64   };
+    static constexpr unsigned RETRIES{ 4096 };
+
+    template< typename Reader > bool read( unsigned i, Reader f ) const {
+      const Slot& S{ slot( i ) };
+      for( auto k: RANGE{ RETRIES } ){
+        if( k >= SPIN ) std::this_thread::yield();
+        const std::uint64_t seq{ S.seq.load( std::memory_order_acquire ) };
+        if( seq == 0 ) return false;
+        if( seq & 1 ) continue;
+        f( S );
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( S.seq.load( std::memory_order_relaxed ) == seq ) return true;
+      }
+      return false;
+    }
+
+  public:
+
+    explicit Subscription( const std::string& name ): size{ 0 }, COUNT{ 0 }, base{ nullptr }{
+      const int fd{ shm_open( name.c_str(), O_RDONLY, 0 ) };
+      if( fd < 0 ) throw std::runtime_error( "Shared memory segment can not be opened: " + name );
+      struct stat st;
+      if( fstat( fd, &st ) != 0 or std::size_t( st.st_size ) < SharedMemory::offset() ){
+        close( fd );
+        throw std::runtime_error( "Shared memory segment is not initialized: " + name );
+      }
+      size = std::size_t( st.st_size );
+      base = mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+      close( fd );
+      if( base == MAP_FAILED ) throw std::runtime_error( "Shared memory segment can not be mapped: " + name );
+      auto H{ static_cast< const SharedMemory::Header* >( base ) };
+      const bool valid{
+        reinterpret_cast< const std::atomic< std::uint64_t >* >( &H->magic )->load( std::memory_order_acquire ) == SharedMemory::MAGIC
+        and H->order  == N
+        and H->real   == sizeof( Real )
+        and H->stride == sizeof( Slot )
+        and SharedMemory::offset() + H->count*sizeof( Slot ) <= size
+      };
+      if( not valid ){
+        munmap( const_cast< void* >( base ), size );
+        throw std::runtime_error( "Shared memory segment has incompatible layout: " + name );
+      }
+      COUNT = unsigned( H->count );
+    }
+
+    Subscription( const Subscription& ) = delete;
+    Subscription& operator= ( const Subscription& ) = delete;
+
+   ~Subscription(){ munmap( const_cast< void* >( base ), size ); }
+
+    unsigned count() const { return COUNT; }
+                                                                                                                              /*
+    Consistent copy of the slot `i` as `Dynamic::def()` does; undefined polynomial if never written or not
+    readable (see `read`):
+                                                                                                                              */
+    std::tuple< Polynomial< N, Real >, Time, Time, Time > def( unsigned i ) const {
+      Real C[ N ];
+      Time To, Tt, Tx;
+      if( not read( i, [&]( const Slot& S ){
+        To = S.To.load( std::memory_order_relaxed );
+        Tt = S.Tt.load( std::memory_order_relaxed );
+        Tx = S.Tx.load( std::memory_order_relaxed );
+        for( auto k: RANGE{ N } ) C[k] = S.C[k].load( std::memory_order_relaxed );
+      }) ){
+        Polynomial< N, Real > P;
+        P.undef();
+        return std::make_tuple( P, 0.0, 0.0, 0.0 );
+      }
+      return std::make_tuple( Polynomial< N, Real >( C ), To, Tt, Tx );
+    }
+                                                                                                                              /*
+    Value of approximation of the slot `i` at time `t` evaluated directly in mapped memory (Horner scheme);
+    NaN if the slot has never been written or is not readable:
+                                                                                                                              */
+    Real operator() ( unsigned i, const Time& t ) const {
+      Real value{ std::numeric_limits< Real >::quiet_NaN() };
+      read( i, [&]( const Slot& S ){
+        const Time To{ S.To.load( std::memory_order_relaxed ) };
+        const Time Tx{ S.Tx.load( std::memory_order_relaxed ) };
+        const Real x { Real( Tx > To ? 2.0*( t - To )/( Tx - To ) - 1.0 : 2.0*( t - To ) - 1.0 ) };
+        value = 0.0;
+        for( auto k: RANGE{ N } ) value = value*x + S.C[k].load( std::memory_order_relaxed );
+      });
+      return value;
+    }
+
+  };//Subscription
+
+}//CoreAGI
+
+#endif // SHMEM_H_INCLUDED
@@ -0,0 +1,216 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+______________________________________________________________________________
+
+ 2026.10.18
+
+ Stress test of the pipeline update -> process -> evaluate: producer threads feed synthetic trajectories
+ (polynomial, sinusoidal, noisy, bursty) into `Dynamic` channels, fitter threads call `process`, reader
+ threads evaluate extrapolation. Reports throughput, latency from the arrival of the sample to the
+ publication of the approximation that includes it (p50/p99/p999), and updates lost by the protocol.
+
+   g++ -std=c++20 -O2 -pthread stress.cpp -o stress
+   ./stress [ channels [ producers [ fitters [ readers [ millisec ] ] ] ] ]
+
+ Race detector build (protocol of `mutexQ`/`mutexP`/`mutexF`/`mutant`):
+
+   g++ -std=c++20 -O1 -g -fsanitize=thread -pthread stress.cpp -o stress-tsan
+   ./stress-tsan 64 2 2 2 1000
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "polynomial.h"
+#include "dynamic.h"
+
+using namespace CoreAGI;
+
+using Time = double;
+using Real = double;
+
+constexpr unsigned N      { 4      };
+constexpr unsigned L      { 32     }; // :queue capacity
+constexpr Time     DT     { 1.0e-3 }; // :time step of samples
+constexpr unsigned HISTORY{ 1024   }; // :arrival stamps kept per channel
+constexpr unsigned BURST  { 64     }; // :samples per burst of bursty channel
+
+enum class Profile: unsigned { POLYNOMIAL = 0, SINUSOIDAL, NOISY, BURSTY };
+                                                                                                                              /*
+Histogram of latencies with 8 buckets per octave of nanoseconds; lock-free, shared by all fitters:
+                                                                                                                              */
+class Histogram {
+
+  static constexpr unsigned B{ 8 };
+  static constexpr unsigned K{ 48*B };
+
+  std::atomic< std::uint64_t > H[ K ];
+
+public:
+
+  Histogram(): H{}{ for( auto& h: H ) h.store( 0 ); }
+
+  void add( double ns ){
+    const unsigned k{ ns < 1.0 ? 0 : unsigned( std::log2( ns )*B ) };
+    H[ k < K ? k : K-1 ].fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  std::uint64_t count() const {
+    std::uint64_t n{ 0 };
+    for( const auto& h: H ) n += h.load();
+    return n;
+  }
+                                                                                                                              /*
+  Upper bound of the bucket that contains quantile `q`, nanosec:
+                                                                                                                              */
+  double quantile( double q ) const {
+    const std::uint64_t n{ count() };
+    std::uint64_t       s{ 0 };
+    for( auto k: RANGE{ K } ){
+      s += H[k].load();
+      if( n > 0 and double( s ) >= q*double( n ) ) return std::exp2( double( k + 1 )/B );
+    }
+    return std::numeric_limits< double >::quiet_NaN();
+  }
+
+};//Histogram
+
+struct Probe {
+  Dynamic< N, Real, Layout::PADDED >                  D;
+  const Profile                                       profile;
+  std::unique_ptr< std::atomic< std::uint64_t >[] >   arrival; // :ticks of arrival by sequence number modulo HISTORY
+  std::atomic< std::uint64_t >                        seq;     // :number of samples fed
+  Probe( unsigned i ):
+    D{ L, Chebyshev4 }, profile{ Profile( i % 4 ) }, arrival{ new std::atomic< std::uint64_t >[ HISTORY ] }, seq{ 0 }
+  {
+    for( auto k: RANGE{ HISTORY } ) arrival[k].store( 0 );
+  }
+};
+
+Real value( const Probe& probe, unsigned i, Time t, std::uint64_t& noise ){
+  switch( probe.profile ){
+    case Profile::POLYNOMIAL:
+    case Profile::BURSTY    : return 1.0 + 0.5*t - 0.1*t*t + 0.01*i;
+    case Profile::SINUSOIDAL: return sin( 3.0*t + i );
+    case Profile::NOISY     :
+      noise = noise*6364136223846793005ULL + 1442695040888963407ULL;
+      return sin( 3.0*t + i ) + 0.05*( double( noise >> 11 )/double( 1ULL << 53 ) - 0.5 );
+  }
+  return 0.0;
+}
+
+int main( int argc, char* argv[] ){
+
+  const unsigned C       { argc > 1 ? unsigned( atoi( argv[1] ) ) : 4096 };
+  const unsigned P       { argc > 2 ? unsigned( atoi( argv[2] ) ) :    2 };
+  const unsigned F       { argc > 3 ? unsigned( atoi( argv[3] ) ) :    2 };
+  const unsigned R       { argc > 4 ? unsigned( atoi( argv[4] ) ) :    2 };
+  const unsigned MILLISEC{ argc > 5 ? unsigned( atoi( argv[5] ) ) : 2000 };
+
+  printf( "\n STRESS TEST: %u channels, %u producers, %u fitters, %u readers, %u millisec\n", C, P, F, R, MILLISEC );
+
+  const double NS{ Cycles::nanosec() };
+  Histogram    latency;
+  std::vector< std::unique_ptr< Probe > > probes;
+  for( auto i: RANGE{ C } ){
+    probes.emplace_back( std::make_unique< Probe >( i ) );
+    Probe& probe{ *probes.back() };
+                                                                                                                              /*
+    Latency measured at publication: sequence number of the newest fitted sample restored from its time:
+                                                                                                                              */
+    probe.D.publisher( [&probe,&latency,NS]( const Polynomial< N, Real >&, const Time&, const Time& Tt, const Time& ){
+      const std::uint64_t now { Cycles::now()                                    };
+      const std::uint64_t k   { std::uint64_t( std::llround( Tt/DT ) ) % HISTORY };
+      const std::uint64_t then{ probe.arrival[k].load( std::memory_order_relaxed ) };
+      if( then > 0 and now > then ) latency.add( NS*double( now - then ) );
+    });
+  }
+
+  std::atomic< bool > producing{ true  };
+  std::atomic< bool > stop     { false };
+  std::atomic< std::uint64_t > updates{ 0 }, fits{ 0 }, reads{ 0 }, undefined{ 0 };
+  std::vector< std::thread > producers, workers;
+
+  for( auto p: RANGE{ P } ) producers.emplace_back( [&,p]{
+    std::uint64_t n{ 0 }, noise{ 0x9e3779b97f4a7c15ULL + p }, round{ 0 };
+    while( producing.load( std::memory_order_relaxed ) ){
+      for( unsigned i = p; i < C; i += P ){
+        Probe& probe{ *probes[i] };
+        const bool     bursty{ probe.profile == Profile::BURSTY };
+        if( bursty and round % BURST != 0 ) continue; // :silent between bursts
+        const unsigned count { bursty ? BURST : 1 };
+        for( auto b: RANGE{ count } ){
+          (void)b;
+          const std::uint64_t s{ probe.seq.load( std::memory_order_relaxed ) };
+          const Time          t{ DT*double( s ) };
+          probe.arrival[ s % HISTORY ].store( Cycles::now(), std::memory_order_relaxed );
+          probe.D.update( t, value( probe, i, t, noise ) );
+          probe.seq.store( s + 1, std::memory_order_relaxed );
+          n++;
+        }
+      }
+      round++;
+    }
+    updates += n;
+  });
+
+  for( auto f: RANGE{ F } ) workers.emplace_back( [&,f]{
+    std::uint64_t n{ 0 };
+    while( not stop.load( std::memory_order_relaxed ) ){
+      for( unsigned i = f; i < C; i += F ) if( probes[i]->D.mutant.load() ){ probes[i]->D.process(); n++; }
+    }
+    fits += n;
+  });
+
+  for( auto r: RANGE{ R } ) workers.emplace_back( [&,r]{
+    std::uint64_t n{ 0 }, nan{ 0 };
+    while( not stop.load( std::memory_order_relaxed ) ){
+      for( unsigned i = r; i < C; i += R ){
+        Probe& probe{ *probes[i] };
+        const Time t{ DT*double( probe.seq.load( std::memory_order_relaxed ) ) };
+        if( std::isnan( probe.D( t ) ) ) nan++;
+        n++;
+      }
+    }
+    reads     += n;
+    undefined += nan;
+  });
+
+  Timer timer;
+  CoreAGI::sleep( MILLISEC );
+  producing.store( false );
+  for( auto& thread: producers ) thread.join();
+  const double sec{ timer.elapsed( Timer::SEC ) };
+  CoreAGI::sleep( 100 ); // :let fitters drain
+  stop.store( true );
+  for( auto& thread: workers ) thread.join();
+                                                                                                                              /*
+  Protocol check: after drain every channel not marked as changed must be fitted up to its newest sample:
+                                                                                                                              */
+  unsigned lost{ 0 };
+  for( auto& probe: probes ){
+    const std::uint64_t s{ probe->seq.load() };
+    if( s == 0 or probe->D.mutant.load() ) continue;
+    const auto[ Q, To, Tt, Tx ] = probe->D.def();
+    if( std::llround( Tt/DT ) != std::int64_t( s - 1 ) ) lost++;
+  }
+
+  printf( "\n   updates %10.3e/sec   fits %10.3e/sec   reads %10.3e/sec ( %llu undefined )",
+    double( updates.load() )/sec, double( fits.load() )/sec, double( reads.load() )/sec, (unsigned long long)undefined.load() );
+  printf( "\n   latency sample -> published fit, microsec: p50 %9.3f   p99 %9.3f   p999 %9.3f   ( %llu fits )",
+    1.0e-3*latency.quantile( 0.5 ), 1.0e-3*latency.quantile( 0.99 ), 1.0e-3*latency.quantile( 0.999 ),
+    (unsigned long long)latency.count() );
+  printf( "\n   lost updates %u\n", lost );
+  printf( "\n Verdict: %s\n", lost == 0 ? "CORRECT" : "FAILURE" );
+
+  return lost == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -7,16 +7,28 @@
  Timer for intervals in sec, millice, microsec, nonesec
 
  2020.05.04
+
+ 2026.10.18 Cycle counter (TSC) timer calibrated against steady clock
+
+ 2026.10.18 Cycle counter calibrated during static initialization, not inside the first measured interval
+
+ 2026.10.18 Calibration without sleep: ticks since program start measured at the first conversion
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef TIMER_H_INCLUDED
 #define TIMER_H_INCLUDED
 
 #include <cassert>
+#include <cstdint>
 
 #include <chrono>
 #include <thread>
 
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h> // :__rdtsc
+#define CORE_AGI_TSC
+#endif
+
 namespace CoreAGI {
 
   void sleep( unsigned millisec ){
@@ -62,6 +74,93 @@ namespace CoreAGI {
     }
 
   };//Timer
+                                                                                                                              /*
+  Cycle counter: time stamp counter of the CPU (constant rate on modern x86) read by single instruction, no
+  system call and no conversion; ticks converted into nanoseconds by the factor calibrated once against
+  steady clock. On other architectures ticks are nanoseconds of steady clock:
+                                                                                                                              */
+  class Cycles {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Origin {
+      Clock::time_point to; // :steady clock at the origin
+      std::uint64_t     co; // :ticks at the origin
+    };
+
+    static const Origin& origin(){
+      static const Origin O{ Clock::now(), now() };
+      return O;
+    }
+
+    static double calibrate(){
+                                                                                                                              /*
+      Ticks counted since the origin against steady clock; interval shorter than `WINDOW` (program that
+      converts ticks right after start) is extended by spinning, no sleep:
+                                                                                                                              */
+#ifdef CORE_AGI_TSC
+      constexpr std::chrono::nanoseconds WINDOW{ std::chrono::milliseconds( 2 ) };
+      const Origin& O{ origin() };
+      Clock::time_point tt{ Clock::now() };
+      while( tt - O.to < WINDOW ) tt = Clock::now();
+      const std::uint64_t ct{ __rdtsc() };
+      const double ns{ double( std::chrono::duration_cast< std::chrono::nanoseconds >( tt - O.to ).count() ) };
+      return ct > O.co ? ns/double( ct - O.co ) : 1.0;
+#else
+      return 1.0;
+#endif
+    }
+
+  public:
+
+    static std::uint64_t now(){
+#ifdef CORE_AGI_TSC
+      return __rdtsc();
+#else
+      return std::uint64_t( std::chrono::duration_cast< std::chrono::nanoseconds >(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif
+    }
+                                                                                                                              /*
+    Nanoseconds per tick; calibrated at the first call over the interval since static initialization of
+    the program (origin), so neither startup nor the first measured interval is delayed by it. Only a call
+    within 2 millisec after start spins for the rest of this interval:
+                                                                                                                              */
+    static double nanosec(){
+      static const double NS{ calibrate() };
+      return NS;
+    }
+
+  private:
+
+    inline static const Origin& ORIGIN{ origin() };
+
+  };//Cycles
+                                                                                                                              /*
+  Timer with the interface of `Timer` based on the cycle counter:
+                                                                                                                              */
+  class CycleTimer {
+
+    std::uint64_t to;
+    std::uint64_t tt;
+
+  public:
+
+    CycleTimer(): to{ Cycles::now() }, tt{ to }{ }
+
+    void start(){ to = Cycles::now(); tt = to; }
+    void stop (){ tt = Cycles::now();          }
+
+    double elapsed( Timer::Unit unit = Timer::MILLISEC ){
+      const std::uint64_t t{ Cycles::now() }; // :the end of the interval read first
+      return Timer::UNIT[ unit ]*Cycles::nanosec()*double( t - to );
+    }
+
+    double operator()( Timer::Unit unit = Timer::MILLISEC ){
+      return Timer::UNIT[ unit ]*Cycles::nanosec()*double( tt - to );
+    }
+
+  };//CycleTimer
 
 }//namespace CoreAGI
 
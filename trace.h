@@ -0,0 +1,185 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+________________________________________________________________________________________________________________________________
+
+  2026.10.18 Initial version: scoped trace zones in per-thread buffers, Chrome trace (Perfetto) JSON output
+
+  2026.10.18 Buffers of exited threads released by `clear`
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef TRACE_H_INCLUDED
+#define TRACE_H_INCLUDED
+
+#include <cstdint>
+#include <cstdio>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "range.h"
+#include "timer.h"
+
+namespace CoreAGI {
+                                                                                                                              /*
+  Trace of zones (named scopes). Each thread records completed zones into own buffer of fixed capacity: the
+  owner thread is the only writer and publishes recorded events by release store of the counter, so
+  recording takes no locks; the mutex is taken only once per thread to register its buffer and by `dump`.
+  Events beyond capacity are counted as dropped. Buffer of exited thread is kept for `dump` until `clear`,
+  which releases it, so memory is bounded by live threads and threads exited since the last `clear`.
+
+  Zones are compiled only when `CORE_AGI_TRACE` defined (`-DCORE_AGI_TRACE`); otherwise `TRACE_ZONE` is empty.
+  Output is JSON of Chrome trace event format, readable by `chrome://tracing` and https://ui.perfetto.dev
+                                                                                                                              */
+  class Trace {
+
+    struct Event {
+      const char*   name; // :string literal
+      std::uint64_t from; // :ticks of `Cycles`
+      std::uint64_t upto; // :ticks of `Cycles`
+    };
+
+    struct Buffer {
+      const unsigned               tid;     // :sequential number of the thread
+      std::unique_ptr< Event[] >   E;
+      std::atomic< unsigned >      count;   // :number of recorded events
+      std::atomic< unsigned long > dropped; // :number of events not recorded due to overflow
+      bool                         alive;   // :owner thread not exited; guarded by mutex of the directory
+      Buffer( unsigned tid ): tid{ tid }, E{ new Event[ CAPACITY ] }, count{ 0 }, dropped{ 0 }, alive{ true }{}
+    };
+
+    struct Directory {
+      std::mutex                               mutex;
+      std::vector< std::unique_ptr< Buffer > > buffers;
+      unsigned                                 threads{ 0 }; // :number of registered threads
+    };
+
+    static Directory& directory(){
+      static Directory D{};
+      return D;
+    }
+                                                                                                                              /*
+    Registration of the thread: buffer added to the directory when the thread records the first zone and
+    marked as released when the thread exits:
+                                                                                                                              */
+    class Owner {
+      Buffer* B;
+    public:
+      Owner(){
+        Directory& D{ directory() };
+        const std::lock_guard< std::mutex > lock( D.mutex );
+        D.buffers.push_back( std::make_unique< Buffer >( ++D.threads ) );
+        B = D.buffers.back().get();
+      }
+      Owner( const Owner& ) = delete;
+      Owner& operator= ( const Owner& ) = delete;
+     ~Owner(){
+        Directory& D{ directory() };
+        const std::lock_guard< std::mutex > lock( D.mutex );
+        B->alive = false;
+      }
+      Buffer& operator*() const { return *B; }
+    };
+
+    static Buffer& buffer(){
+      thread_local const Owner B{};
+      return *B;
+    }
+
+  public:
+
+    static constexpr unsigned CAPACITY{ 1u << 16 }; // :events per thread
+
+    static void record( const char* name, std::uint64_t from, std::uint64_t upto ){
+      Buffer& B{ buffer() };
+      const unsigned n{ B.count.load( std::memory_order_relaxed ) };
+      if( n >= CAPACITY ){ B.dropped.fetch_add( 1, std::memory_order_relaxed ); return; }
+      B.E[n] = Event{ name, from, upto };
+      B.count.store( n + 1, std::memory_order_release );
+    }
+                                                                                                                              /*
+    Scoped zone: recorded when destroyed:
+                                                                                                                              */
+    class Zone {
+      const char*         name;
+      const std::uint64_t from;
+    public:
+      explicit Zone( const char* name ): name{ name }, from{ Cycles::now() }{}
+      Zone( const Zone& ) = delete;
+      Zone& operator= ( const Zone& ) = delete;
+     ~Zone(){ record( name, from, Cycles::now() ); }
+    };
+                                                                                                                              /*
+    Write recorded events as Chrome trace JSON; returns number of written events. Events recorded
+    concurrently with `dump` may be missed, never torn:
+                                                                                                                              */
+    static unsigned long dump( FILE* file ){
+      Directory& D{ directory() };
+      const std::lock_guard< std::mutex > lock( D.mutex );
+      const double ns{ Cycles::nanosec() };
+      unsigned long n{ 0 }, dropped{ 0 };
+      std::uint64_t origin{ ~std::uint64_t( 0 ) }; // :the earliest event is the origin of the time line
+      for( const auto& B: D.buffers ){
+        const unsigned count{ B->count.load( std::memory_order_acquire ) };
+        for( auto i: RANGE{ count } ) if( B->E[i].from < origin ) origin = B->E[i].from;
+      }
+      fprintf( file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" );
+      for( const auto& B: D.buffers ){
+        const unsigned count{ B->count.load( std::memory_order_acquire ) };
+        for( auto i: RANGE{ count } ){
+          const Event& e{ B->E[i] };
+          fprintf( file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            n++ > 0 ? "," : "", e.name, B->tid,
+            1.0e-3*ns*double( e.from - origin ), 1.0e-3*ns*double( e.upto - e.from ) );
+        }
+        dropped += B->dropped.load( std::memory_order_relaxed );
+      }
+      fprintf( file, "\n],\"otherData\":{\"dropped\":%lu}}\n", dropped );
+      return n;
+    }
+
+    static bool dump( const char* path ){
+      FILE* file{ fopen( path, "w" ) };
+      if( not file ) return false;
+      dump( file );
+      return fclose( file ) == 0;
+    }
+                                                                                                                              /*
+    Number of held buffers: threads that recorded zones and are alive or exited since the last `clear`:
+                                                                                                                              */
+    static unsigned buffers(){
+      Directory& D{ directory() };
+      const std::lock_guard< std::mutex > lock( D.mutex );
+      return unsigned( D.buffers.size() );
+    }
+                                                                                                                              /*
+    Forget recorded events and release buffers of exited threads; caller ensures no zone is recorded
+    concurrently:
+                                                                                                                              */
+    static void clear(){
+      Directory& D{ directory() };
+      const std::lock_guard< std::mutex > lock( D.mutex );
+      std::erase_if( D.buffers, []( const auto& B ){ return not B->alive; } );
+      for( const auto& B: D.buffers ){
+        B->count.store( 0 );
+        B->dropped.store( 0 );
+      }
+    }
+
+  };//Trace
+
+}//CoreAGI
+
+#define TRACE_CONCAT_( a, b ) a##b
+#define TRACE_CONCAT( a, b ) TRACE_CONCAT_( a, b )
+
+#ifdef CORE_AGI_TRACE
+  #define TRACE_ZONE( name ) const CoreAGI::Trace::Zone TRACE_CONCAT( zone_, __LINE__ ){ name }
+#else
+  #define TRACE_ZONE( name )
+#endif
+
+#endif // TRACE_H_INCLUDED